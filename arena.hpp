@@ -0,0 +1,193 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <limits>
+#include "utils.hpp"
+
+namespace ft {
+//	Monotonic memory resource: allocations bump a pointer through the current block and are never freed one by one.
+//	Blocks come from an optional initial buffer, then from the upstream arena if there is one or from operator new otherwise, each twice as large as the previous one.
+//	release() gives back every block obtained from operator new at once and starts over from the initial buffer, blocks taken from the upstream return with the upstream's own release().
+    class arena {
+    private:
+        struct block {
+            block*	next;
+            size_t	size;
+        };
+
+        char*	_initial;
+        size_t	_initial_size;
+        arena*	_upstream;
+        block*	_blocks;
+        char*	_current;
+        size_t	_left;
+        size_t	_next_size;
+
+        arena(const arena&);
+        arena& operator=(const arena&);
+
+        static size_t align_up(size_t n, size_t alignment) {
+            return (n + alignment - 1) / alignment * alignment;
+        }
+
+//		Starts a new block big enough for bytes with the given alignment.
+        void grow(size_t bytes, size_t alignment) {
+            size_t size = _next_size;
+
+            if (size < bytes + alignment)
+                size = bytes + alignment;
+            if (_upstream) {
+                _current = static_cast<char*>(_upstream->allocate(size, alignment));
+                _left = size;
+            }
+            else {
+                const size_t header = align_up(sizeof(block), sizeof(void*) * 2);
+                block* fresh = static_cast<block*>(::operator new(header + size));
+
+                fresh->next = _blocks;
+                fresh->size = header + size;
+                _blocks = fresh;
+                _current = reinterpret_cast<char*>(fresh) + header;
+                _left = size;
+            }
+            _next_size = size * 2;
+        }
+
+    public:
+        explicit arena(size_t first_block = 4096, arena* upstream = 0) : _initial(0), _initial_size(0), _upstream(upstream), _blocks(0), _current(0), _left(0), _next_size(first_block ? first_block : 1) {}
+
+        arena(void* buffer, size_t size, arena* upstream = 0) : _initial(static_cast<char*>(buffer)), _initial_size(size), _upstream(upstream), _blocks(0), _current(static_cast<char*>(buffer)), _left(size), _next_size(size ? size * 2 : 4096) {}
+
+        ~arena() {
+            release();
+        }
+
+        void* allocate(size_t bytes, size_t alignment = sizeof(void*)) {
+            size_t padding = (alignment - reinterpret_cast<size_t>(_current) % alignment) % alignment;
+
+            if (!_current || padding + bytes > _left) {
+                grow(bytes, alignment);
+                padding = (alignment - reinterpret_cast<size_t>(_current) % alignment) % alignment;
+            }
+            char* result = _current + padding;
+            _current = result + bytes;
+            _left -= padding + bytes;
+            return result;
+        }
+
+//		Individual deallocation is a no-op, memory comes back with release().
+        void deallocate(void*, size_t) {}
+
+        void release() {
+            while (_blocks) {
+                block* next = _blocks->next;
+                ::operator delete(_blocks);
+                _blocks = next;
+            }
+            _current = _initial;
+            _left = _initial_size;
+            _next_size = _initial_size ? _initial_size * 2 : _next_size;
+        }
+
+        arena* upstream() const {
+            return _upstream;
+        }
+    };
+
+//	C++98 allocator that takes its memory from an ft::arena, so every container rebound from it shares the arena.
+//	A default constructed arena_allocator has no arena and falls back to operator new and delete.
+    template <class T>
+    class arena_allocator {
+    public:
+        typedef T				value_type;
+        typedef T*				pointer;
+        typedef const T*		const_pointer;
+        typedef T&				reference;
+        typedef const T&		const_reference;
+        typedef size_t			size_type;
+        typedef std::ptrdiff_t	difference_type;
+
+        template <class U>
+        struct rebind {
+            typedef arena_allocator<U> other;
+        };
+    private:
+        ft::arena*	_arena;
+
+        template <class U>
+        friend class arena_allocator;
+    public:
+        arena_allocator() : _arena(0) {}
+
+        arena_allocator(ft::arena& arena) : _arena(&arena) {}
+
+        arena_allocator(const arena_allocator& other) : _arena(other._arena) {}
+
+        template <class U>
+        arena_allocator(const arena_allocator<U>& other) : _arena(other._arena) {}
+
+        ~arena_allocator() {}
+
+        arena_allocator& operator=(const arena_allocator& other) {
+            _arena = other._arena;
+            return *this;
+        }
+
+        pointer allocate(size_type n, const void* = 0) {
+            if (n > max_size())
+                throw std::bad_alloc();
+            if (!_arena)
+                return static_cast<pointer>(::operator new(n * sizeof(T)));
+            return static_cast<pointer>(_arena->allocate(n * sizeof(T), ft::alignment_of<T>::value));
+        }
+
+        void deallocate(pointer p, size_type n) {
+            if (!_arena)
+                ::operator delete(p);
+            else
+                _arena->deallocate(p, n * sizeof(T));
+        }
+
+        size_type max_size() const {
+            return std::numeric_limits<size_type>::max() / sizeof(T);
+        }
+
+        void construct(pointer p, const_reference val) {
+            ::new(static_cast<void*>(p)) T(val);
+        }
+
+#if __cplusplus >= 201103L
+        template <class U, class... Args>
+        void construct(U* p, Args&&... args) {
+            ::new(static_cast<void*>(p)) U(std::forward<Args>(args)...);
+        }
+#endif
+
+        void destroy(pointer p) {
+            p->~T();
+        }
+
+        pointer address(reference x) const {
+            return &x;
+        }
+
+        const_pointer address(const_reference x) const {
+            return &x;
+        }
+
+        ft::arena* resource() const {
+            return _arena;
+        }
+
+        template <class U>
+        bool operator==(const arena_allocator<U>& other) const {
+            return _arena == other._arena;
+        }
+
+        template <class U>
+        bool operator!=(const arena_allocator<U>& other) const {
+            return _arena != other._arena;
+        }
+    };
+}
@@ -0,0 +1,886 @@
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <ctime>
+#include <pthread.h>
+#include <sys/time.h>
+#include <vector>
+#include <map>
+#include <set>
+#include <string>
+#include <cstdio>
+#include "vector.hpp"
+#include "small_vector.hpp"
+#include "map.hpp"
+#include "set.hpp"
+#include "btree_map.hpp"
+#include "flat_map.hpp"
+#include "unordered_map.hpp"
+#include "concurrent_map.hpp"
+#include "persistent_map.hpp"
+#include "thread_cache.hpp"
+
+//	Processor time in milliseconds, precise enough for workloads that run for tens of milliseconds.
+static double now() {
+	return static_cast<double>(std::clock()) * 1000.0 / CLOCKS_PER_SEC;
+}
+
+//	Wall clock in milliseconds, processor time would add up the threads.
+static double wall() {
+	timeval tv;
+
+	gettimeofday(&tv, 0);
+	return tv.tv_sec * 1000.0 + tv.tv_usec / 1000.0;
+}
+
+static void report(const char* name, double stdTime, double ftTime) {
+	std::cout << std::left << std::setw(28) << name << std::right << std::fixed << std::setprecision(2)
+		<< std::setw(10) << stdTime << " ms" << std::setw(10) << ftTime << " ms" << std::endl;
+}
+
+//	std::allocator that counts the calls to allocate.
+static size_t g_allocations = 0;
+
+template <class T>
+struct counting_allocator : public std::allocator<T> {
+	template <class U>
+	struct rebind {
+		typedef counting_allocator<U> other;
+	};
+
+	counting_allocator() {}
+
+	template <class U>
+	counting_allocator(const counting_allocator<U>&) {}
+
+	T* allocate(size_t n, const void* = 0) {
+		++g_allocations;
+		return std::allocator<T>::allocate(n);
+	}
+};
+
+//	counting_allocator that Tree does not pool, one allocator call per node like before the node pool.
+template <class T>
+struct unpooled_allocator : public counting_allocator<T> {
+	template <class U>
+	struct rebind {
+		typedef unpooled_allocator<U> other;
+	};
+
+	unpooled_allocator() {}
+
+	template <class U>
+	unpooled_allocator(const unpooled_allocator<U>&) {}
+};
+
+namespace ft {
+	template <class T>
+	struct use_node_pool<unpooled_allocator<T> > : public ft::false_type {};
+}
+
+//	std::allocator that keeps the number of bytes currently allocated through it.
+static size_t g_live_bytes = 0;
+
+template <class T>
+struct byte_counting_allocator : public std::allocator<T> {
+	template <class U>
+	struct rebind {
+		typedef byte_counting_allocator<U> other;
+	};
+
+	byte_counting_allocator() {}
+
+	template <class U>
+	byte_counting_allocator(const byte_counting_allocator<U>&) {}
+
+	T* allocate(size_t n, const void* = 0) {
+		g_live_bytes += n * sizeof(T);
+		return std::allocator<T>::allocate(n);
+	}
+
+	void deallocate(T* p, size_t n) {
+		g_live_bytes -= n * sizeof(T);
+		std::allocator<T>::deallocate(p, n);
+	}
+};
+
+static void report_allocations(const char* name, size_t stdCount, size_t ftCount) {
+	std::cout << std::left << std::setw(28) << name << std::right << std::setw(10) << stdCount << " al" << std::setw(10) << ftCount << " al" << std::endl;
+}
+
+//	Fills `rounds` fresh vectors with n elements through push_back only.
+template <class Vector>
+double push_back_fill(size_t n, size_t rounds) {
+	double start = now();
+	size_t sum = 0;
+
+	for (size_t r = 0; r < rounds; ++r) {
+		Vector v;
+		for (size_t i = 0; i < n; ++i)
+			v.push_back(static_cast<typename Vector::value_type>(i));
+		sum += v.size();
+	}
+	if (sum != n * rounds)
+		std::cout << "unexpected size" << std::endl;
+	return now() - start;
+}
+
+//	Grows one vector through resize and insert at the end, the other two paths that share the growth policy.
+template <class Vector>
+double resize_insert_fill(size_t n, size_t rounds) {
+	double start = now();
+
+	for (size_t r = 0; r < rounds; ++r) {
+		Vector v;
+		for (size_t i = 0; i < n / 2; ++i)
+			v.insert(v.end(), static_cast<typename Vector::value_type>(i));
+		for (size_t i = n / 2; i < n; i += 8)
+			v.resize(i + 8);
+	}
+	return now() - start;
+}
+
+//	Inserts into and erases from the middle, the element shifting dominates.
+template <class Vector>
+double middle_insert_erase(size_t n, size_t rounds) {
+	double start = now();
+	Vector v(n, typename Vector::value_type());
+
+	for (size_t r = 0; r < rounds; ++r) {
+		v.insert(v.begin() + v.size() / 2, typename Vector::value_type());
+		v.erase(v.begin() + v.size() / 3);
+	}
+	return now() - start;
+}
+
+//	Appends batches taken from a source vector through the range insert.
+template <class Vector>
+double range_append(size_t batch, size_t rounds) {
+	double start = now();
+	Vector source(batch, typename Vector::value_type());
+	Vector v;
+
+	for (size_t r = 0; r < rounds; ++r)
+		v.insert(v.end(), source.begin(), source.end());
+	return now() - start;
+}
+
+//	Builds many short-lived vectors of 0 to 7 elements, the typical small-vector workload.
+template <class Vector>
+double small_fills(size_t count, size_t& allocations) {
+	double start = now();
+	size_t sum = 0;
+
+	g_allocations = 0;
+	for (size_t r = 0; r < count; ++r) {
+		Vector v;
+		for (size_t i = 0; i < r % 8; ++i)
+			v.push_back(static_cast<int>(i));
+		sum += v.size();
+	}
+	allocations = g_allocations;
+	if (!sum)
+		std::cout << "unexpected size" << std::endl;
+	return now() - start;
+}
+
+//	Fills a map with n keys then keeps erasing and reinserting keys, the steady churn of a long-lived map.
+template <class Map>
+double map_churn(size_t n, size_t rounds, size_t& allocations) {
+	double start = now();
+	size_t seed = 12345;
+	Map m;
+
+	g_allocations = 0;
+	for (size_t i = 0; i < n; ++i)
+		m[static_cast<int>(i)] = static_cast<int>(i);
+	for (size_t r = 0; r < rounds; ++r) {
+		seed = seed * 1103515245 + 12345;
+		int key = static_cast<int>((seed >> 8) % n);
+		m.erase(key);
+		m[key] = key;
+	}
+	allocations = g_allocations;
+	if (m.size() != n)
+		std::cout << "unexpected size" << std::endl;
+	return now() - start;
+}
+
+//	operator[] on keys that are all present, the lookup-or-insert path must not allocate on a hit.
+template <class Map>
+double map_subscript_hits(size_t n, size_t rounds) {
+	double start = now();
+	Map m;
+	int sum = 0;
+
+	for (size_t i = 0; i < n; ++i)
+		m[static_cast<int>(i)] = 1;
+	for (size_t r = 0; r < rounds; ++r)
+		sum += m[static_cast<int>(r * 7 % n)];
+	if (static_cast<size_t>(sum) != rounds)
+		std::cout << "unexpected sum" << std::endl;
+	return now() - start;
+}
+
+//	Looks up string keys given as Key, either std::string or const char* which a map without a transparent comparator converts to a temporary std::string.
+template <class Map, class Key>
+double string_lookups(size_t n, size_t rounds) {
+	std::vector<std::string> names;
+	Map m;
+
+	for (size_t i = 0; i < n; ++i) {
+		char name[64];
+		std::sprintf(name, "a reasonably long key name number %lu", static_cast<unsigned long>(i));
+		names.push_back(name);
+		m[name].push_back(static_cast<int>(i));
+	}
+	double start = now();
+	size_t found = 0;
+	for (size_t r = 0; r < rounds; ++r)
+		found += m.count(static_cast<Key>(names[r * 7 % n].c_str()));
+	if (found != rounds)
+		std::cout << "unexpected count" << std::endl;
+	return now() - start;
+}
+
+//	Hinted inserts: ascending keys at end(), descending keys before the previous insert, random keys at end() where the hint is useless.
+template <class Map>
+double hinted_inserts(size_t n, size_t rounds, int order) {
+	double start = now();
+	size_t seed = 777;
+
+	for (size_t r = 0; r < rounds; ++r) {
+		Map m;
+		typename Map::iterator hint = m.end();
+		for (size_t i = 0; i < n; ++i) {
+			int key;
+			if (order > 0)
+				key = static_cast<int>(i);
+			else if (order < 0)
+				key = static_cast<int>(n - i);
+			else {
+				seed = seed * 1103515245 + 12345;
+				key = static_cast<int>((seed >> 8) % (n * 4));
+			}
+			hint = m.insert(order < 0 ? hint : m.end(), typename Map::value_type(key, key));
+		}
+	}
+	return now() - start;
+}
+
+//	Builds a set from a sorted vector through the range constructor.
+template <class Set, class Vector>
+double sorted_build(size_t n, size_t rounds) {
+	Vector keys;
+
+	for (size_t i = 0; i < n; ++i)
+		keys.push_back(static_cast<int>(i * 3));
+	double start = now();
+	for (size_t r = 0; r < rounds; ++r) {
+		Set s(keys.begin(), keys.end());
+		if (s.size() != n)
+			std::cout << "unexpected size" << std::endl;
+	}
+	return now() - start;
+}
+
+//	Adds a small set to a large one, element by element for std::set and with one set_union for ft::set.
+void add_all(std::set<int>& s, const std::set<int>& small) {
+	s.insert(small.begin(), small.end());
+}
+
+void add_all(ft::set<int>& s, const ft::set<int>& small) {
+	s.set_union(small);
+}
+
+template <class Set>
+double small_unions(size_t n, size_t m, size_t rounds) {
+	Set s;
+	size_t seed = 5;
+	double total = 0;
+
+	for (size_t i = 0; i < n; ++i)
+		s.insert(static_cast<int>(i * 2));
+	for (size_t r = 0; r < rounds; ++r) {
+		Set small;
+		for (size_t i = 0; i < m; ++i) {
+			seed = seed * 1103515245 + 12345;
+			small.insert(static_cast<int>((seed >> 8) % (n * 2)));
+		}
+		double start = now();
+		add_all(s, small);
+		total += now() - start;
+	}
+	return total;
+}
+
+//	Cuts a set in two at k and puts it back together: copy and erase for std::set, split_at and join for ft::set.
+void cut_and_rejoin(std::set<int>& s, int k) {
+	std::set<int> high(s.lower_bound(k), s.end());
+
+	s.erase(s.lower_bound(k), s.end());
+	s.insert(high.begin(), high.end());
+}
+
+void cut_and_rejoin(ft::set<int>& s, int k) {
+	ft::set<int> high;
+
+	s.split_at(k, high);
+	s.join(high);
+}
+
+template <class Set>
+double split_joins(size_t n, size_t rounds) {
+	Set s;
+	size_t seed = 17;
+
+	for (size_t i = 0; i < n; ++i)
+		s.insert(static_cast<int>(i));
+	double start = now();
+	for (size_t r = 0; r < rounds; ++r) {
+		seed = seed * 1103515245 + 12345;
+		cut_and_rejoin(s, static_cast<int>((seed >> 8) % n));
+	}
+	if (s.size() != n)
+		std::cout << "unexpected size" << std::endl;
+	return now() - start;
+}
+
+//	Moves one entry between two shards, a copy and an erase for std::map, extract() and insert() of the node for ft::map.
+void move_entry(std::map<int, std::string>& from, std::map<int, std::string>& to, int key) {
+	std::map<int, std::string>::iterator it = from.find(key);
+
+	if (it != from.end()) {
+		to.insert(*it);
+		from.erase(it);
+	}
+}
+
+void move_entry(ft::map<int, std::string>& from, ft::map<int, std::string>& to, int key) {
+	to.insert(from.extract(key));
+}
+
+template <class Map>
+double shard_moves(size_t n, size_t moves) {
+	Map shards[2];
+	size_t seed = 31;
+
+	for (size_t i = 0; i < n; ++i)
+		shards[i % 2][static_cast<int>(i)] = std::string(64, 'v');
+	double start = now();
+	for (size_t m = 0; m < moves; ++m) {
+		seed = seed * 1103515245 + 12345;
+		int key = static_cast<int>((seed >> 8) % n);
+		size_t from = shards[0].count(key) ? 0 : 1;
+		move_entry(shards[from], shards[1 - from], key);
+	}
+	if (shards[0].size() + shards[1].size() != n)
+		std::cout << "unexpected size" << std::endl;
+	return now() - start;
+}
+
+//	Snapshots a map: copy construction, then assignment over the previous snapshot.
+template <class Map>
+double map_snapshots(size_t n, size_t rounds) {
+	Map source;
+	size_t seed = 99;
+
+	for (size_t i = 0; i < n; ++i) {
+		seed = seed * 1103515245 + 12345;
+		source[static_cast<int>(seed >> 4)] = static_cast<int>(i);
+	}
+	double start = now();
+	Map snapshot(source);
+	for (size_t r = 0; r < rounds; ++r)
+		snapshot = source;
+	if (snapshot.size() != source.size())
+		std::cout << "unexpected size" << std::endl;
+	return now() - start;
+}
+
+//	Full forward and backward scans, plus begin() and --end() lookups.
+template <class Map>
+double map_scans(size_t n, size_t rounds) {
+	Map m;
+
+	for (size_t i = 0; i < n; ++i)
+		m[static_cast<int>(i * 13 % n)] = 1;
+	double start = now();
+	size_t sum = 0;
+	for (size_t r = 0; r < rounds; ++r) {
+		for (typename Map::const_iterator it = m.begin(); it != m.end(); ++it)
+			sum += it->second;
+		for (typename Map::const_reverse_iterator it = m.rbegin(); it != m.rend(); ++it)
+			sum += it->second;
+		for (size_t i = 0; i < 1000; ++i)
+			sum += m.begin()->second + (--m.end())->second;
+	}
+	if (sum != rounds * (2 * n + 2000))
+		std::cout << "unexpected sum" << std::endl;
+	return now() - start;
+}
+
+//	Sliding time window: appends a batch of new keys and expires the oldest batch with a range erase.
+template <class Map>
+double window_expiry(size_t window, size_t batch, size_t rounds) {
+	Map m;
+	int next = 0;
+
+	for (size_t i = 0; i < window; ++i, ++next)
+		m.insert(m.end(), typename Map::value_type(next, next));
+	double start = now();
+	for (size_t r = 0; r < rounds; ++r) {
+		for (size_t i = 0; i < batch; ++i, ++next)
+			m.insert(m.end(), typename Map::value_type(next, next));
+		m.erase(m.begin(), m.lower_bound(next - static_cast<int>(window)));
+	}
+	if (m.size() != window)
+		std::cout << "unexpected size" << std::endl;
+	return now() - start;
+}
+
+//	Lookups of present and absent keys in a map of n keys, in nanoseconds per lookup.
+template <class Map>
+double lookup_ns(size_t n, size_t lookups) {
+	Map m;
+	size_t seed = 4242;
+
+	for (size_t i = 0; i < n; ++i)
+		m[static_cast<int>(i * 2)] = 1;
+	double start = now();
+	size_t found = 0;
+	for (size_t r = 0; r < lookups; ++r) {
+		seed = seed * 1103515245 + 12345;
+		int key = static_cast<int>((seed >> 8) % (n * 2));
+		found += m.find(key) != m.end();
+		found += m.lower_bound(key) != m.end();
+	}
+	if (!found)
+		std::cout << "unexpected count" << std::endl;
+	return (now() - start) * 1000000.0 / (lookups * 2);
+}
+
+//	Reads percentiles of a map of n keys by advancing begin(), O(log n) per query with FT_ORDER_STATISTICS and linear otherwise.
+template <class Map>
+double percentiles(size_t n, size_t queries) {
+	Map m;
+	size_t seed = 77;
+	long sum = 0;
+
+	for (size_t i = 0; i < n; ++i)
+		m[static_cast<int>(i)] = static_cast<int>(i);
+	double start = now();
+	for (size_t q = 0; q < queries; ++q) {
+		seed = seed * 1103515245 + 12345;
+		typename Map::iterator it = m.begin();
+		advance(it, (seed >> 8) % n);
+		sum += it->second;
+	}
+	if (sum < 0)
+		std::cout << "unexpected sum" << std::endl;
+	return now() - start;
+}
+
+//	Bytes the map holds per element once filled with n random keys by a range insert, Map must allocate through byte_counting_allocator.
+template <class Map, class Pair>
+double bytes_per_element(size_t n) {
+	std::vector<Pair> pairs;
+	size_t seed = 99;
+
+	for (size_t i = 0; i < n; ++i) {
+		seed = seed * 1103515245 + 12345;
+		pairs.push_back(Pair(static_cast<int>(seed >> 8), 1));
+	}
+	size_t before = g_live_bytes;
+	Map m(pairs.begin(), pairs.end());
+	return static_cast<double>(g_live_bytes - before) / m.size();
+}
+
+//	Forward scans over a map of n keys built from a sorted range, in nanoseconds per element.
+template <class Map, class Pair>
+double scan_ns(size_t n, size_t rounds) {
+	std::vector<Pair> pairs;
+
+	for (size_t i = 0; i < n; ++i)
+		pairs.push_back(Pair(static_cast<int>(i), 1));
+	Map m(pairs.begin(), pairs.end());
+	double start = now();
+	size_t sum = 0;
+	for (size_t r = 0; r < rounds; ++r) {
+		for (typename Map::const_iterator it = m.begin(); it != m.end(); ++it)
+			sum += it->second;
+	}
+	if (sum != rounds * n)
+		std::cout << "unexpected sum" << std::endl;
+	return (now() - start) * 1000000.0 / (rounds * n);
+}
+
+//	find() of present and absent keys in a map of n keys spread over the int range, in nanoseconds per lookup.
+template <class Map>
+double find_ns(size_t n, size_t lookups) {
+	Map m;
+	size_t seed = 2024;
+
+	for (size_t i = 0; i < n; ++i)
+		m[static_cast<int>(i * 2654435761U)] = 1;
+	double start = now();
+	size_t found = 0;
+	for (size_t r = 0; r < lookups; ++r) {
+		seed = seed * 1103515245 + 12345;
+		found += m.find(static_cast<int>(((seed >> 8) % (n * 2)) * 2654435761U)) != m.end();
+	}
+	if (!found)
+		std::cout << "unexpected count" << std::endl;
+	return (now() - start) * 1000000.0 / lookups;
+}
+
+//	Keeps n random keys in a map while erasing one and inserting another, the churn of a cache or a session table.
+template <class Map>
+double point_churn(size_t n, size_t ops) {
+	Map m;
+	std::vector<int> keys;
+	size_t seed = 31;
+
+	for (size_t i = 0; i < n; ++i) {
+		seed = seed * 1103515245 + 12345;
+		keys.push_back(static_cast<int>(seed >> 4));
+		m[keys.back()] = 1;
+	}
+	double start = now();
+	for (size_t i = 0; i < ops; ++i) {
+		seed = seed * 1103515245 + 12345;
+		size_t victim = (seed >> 8) % n;
+		m.erase(keys[victim]);
+		keys[victim] = static_cast<int>(seed >> 4);
+		m[keys[victim]] = 1;
+	}
+	return now() - start;
+}
+
+//	Builds and clears a map over and over, the pool hands its slabs back on clear().
+template <class Map>
+double map_fill_clear(size_t n, size_t rounds) {
+	double start = now();
+	Map m;
+
+	for (size_t r = 0; r < rounds; ++r) {
+		for (size_t i = 0; i < n; ++i)
+			m.insert(typename Map::value_type(static_cast<int>(i * 7 % n), 0));
+		m.clear();
+	}
+	return now() - start;
+}
+
+//	Every worker churns its own map and regularly builds a short-lived map that it swaps with the one another worker left in a shared slot, so nodes are freed by a thread that did not allocate them.
+template <class Map>
+struct threaded_churn {
+	static pthread_mutex_t	lock;
+	static Map*				slot;
+
+	static void* worker(void* arg) {
+		size_t seed = reinterpret_cast<size_t>(arg) * 7919 + 1;
+		Map m;
+
+		for (size_t r = 0; r < 200000; ++r) {
+			seed = seed * 1103515245 + 12345;
+			int key = static_cast<int>((seed >> 8) % 1000);
+			m.erase(key);
+			m[key] = key;
+			if (r % 500 == 0) {
+				Map* mine = new Map;
+				for (int i = 0; i < 200; ++i)
+					(*mine)[i] = i;
+				pthread_mutex_lock(&lock);
+				Map* other = slot;
+				slot = mine;
+				pthread_mutex_unlock(&lock);
+				delete other;
+			}
+		}
+		return 0;
+	}
+
+//	Same work per thread, so perfect scaling keeps the time flat.
+	static double run(size_t threads) {
+		pthread_t workers[16];
+		double start = wall();
+
+		for (size_t i = 0; i < threads; ++i)
+			pthread_create(&workers[i], 0, &worker, reinterpret_cast<void*>(i));
+		for (size_t i = 0; i < threads; ++i)
+			pthread_join(workers[i], 0);
+		delete slot;
+		slot = 0;
+		return wall() - start;
+	}
+};
+
+template <class Map>
+pthread_mutex_t threaded_churn<Map>::lock = PTHREAD_MUTEX_INITIALIZER;
+
+template <class Map>
+Map* threaded_churn<Map>::slot = 0;
+
+//	Updates a map of n keys and publishes every version as a copy, the way readers get a stable ft::map today.
+template <class Map>
+double copied_versions(size_t n, size_t versions) {
+	Map live;
+
+	for (size_t i = 0; i < n; ++i)
+		live.insert(typename Map::value_type(static_cast<int>(i), 0));
+	double start = now();
+	for (size_t r = 0; r < versions; ++r) {
+		live[static_cast<int>(r * 7919 % n)] = static_cast<int>(r);
+		Map published(live);
+		if (published.size() != n)
+			std::cout << "unexpected size" << std::endl;
+	}
+	return now() - start;
+}
+
+//	Same with persistent_map: the update copies one path and the published version is a snapshot.
+static double persistent_versions(size_t n, size_t versions) {
+	ft::persistent_map<int, int> live;
+
+	for (size_t i = 0; i < n; ++i)
+		live.insert(ft::pair<const int, int>(static_cast<int>(i), 0));
+	double start = now();
+	for (size_t r = 0; r < versions; ++r) {
+		live.insert_or_assign(static_cast<int>(r * 7919 % n), static_cast<int>(r));
+		ft::persistent_map<int, int> published(live.snapshot());
+		if (published.size() != n)
+			std::cout << "unexpected size" << std::endl;
+	}
+	return now() - start;
+}
+
+//	find() in a published version of a map of n keys, half of them present, in nanoseconds per lookup.
+template <class Map>
+double version_find_ns(size_t n, size_t lookups) {
+	Map live;
+	size_t seed = 606;
+
+	for (size_t i = 0; i < n; ++i)
+		live.insert(typename Map::value_type(static_cast<int>(i * 2), 1));
+	const Map published(live);
+	double start = now();
+	size_t found = 0;
+	for (size_t r = 0; r < lookups; ++r) {
+		seed = seed * 1103515245 + 12345;
+		found += published.find(static_cast<int>((seed >> 8) % (n * 2))) != published.end();
+	}
+	if (!found)
+		std::cout << "unexpected count" << std::endl;
+	return (now() - start) * 1000000.0 / lookups;
+}
+
+//	What the request threads share today: one ft::map behind one mutex, with the interface of concurrent_map.
+struct mutex_map {
+	pthread_mutex_t		lock;
+	ft::map<int, int>	map;
+
+	mutex_map() {
+		pthread_mutex_init(&lock, 0);
+	}
+
+	~mutex_map() {
+		pthread_mutex_destroy(&lock);
+	}
+
+	bool find(int key, int& out) {
+		pthread_mutex_lock(&lock);
+		ft::map<int, int>::iterator it = map.find(key);
+		bool found = it != map.end();
+		if (found)
+			out = it->second;
+		pthread_mutex_unlock(&lock);
+		return found;
+	}
+
+	void insert_or_assign(int key, int value) {
+		pthread_mutex_lock(&lock);
+		map[key] = value;
+		pthread_mutex_unlock(&lock);
+	}
+
+	void erase(int key) {
+		pthread_mutex_lock(&lock);
+		map.erase(key);
+		pthread_mutex_unlock(&lock);
+	}
+};
+
+//	All workers share one map of 100k keys: 90% lookups, 5% overwrites and 5% erases.
+template <class Map>
+struct threaded_mix {
+	static Map*	shared;
+
+	static void* worker(void* arg) {
+		size_t seed = reinterpret_cast<size_t>(arg) * 7919 + 1;
+		int value = 0;
+
+		for (size_t r = 0; r < 500000; ++r) {
+			seed = seed * 1103515245 + 12345;
+			int key = static_cast<int>((seed >> 8) % 100000);
+			size_t op = (seed >> 4) % 20;
+			if (op == 0)
+				shared->insert_or_assign(key, key);
+			else if (op == 1)
+				shared->erase(key);
+			else
+				shared->find(key, value);
+		}
+		return 0;
+	}
+
+//	Same work per thread, so perfect scaling keeps the time flat.
+	static double run(Map& m, size_t threads) {
+		pthread_t workers[16];
+
+		for (int i = 0; i < 100000; ++i)
+			m.insert_or_assign(i, i);
+		shared = &m;
+		double start = wall();
+		for (size_t i = 0; i < threads; ++i)
+			pthread_create(&workers[i], 0, &worker, reinterpret_cast<void*>(i));
+		for (size_t i = 0; i < threads; ++i)
+			pthread_join(workers[i], 0);
+		shared = 0;
+		return wall() - start;
+	}
+};
+
+template <class Map>
+Map* threaded_mix<Map>::shared = 0;
+
+int main() {
+	std::cout << "=========================================================" << std::endl;
+	std::cout << "   BENCHMARK                       STD           FT      " << std::endl;
+	std::cout << "___________________________________|_____________________" << std::endl;
+
+//  VECTOR growth
+	report("push_back 1M int", push_back_fill<std::vector<int> >(1000000, 10), push_back_fill<ft::vector<int> >(1000000, 10));
+	report("push_back 10k int x 1000", push_back_fill<std::vector<int> >(10000, 1000), push_back_fill<ft::vector<int> >(10000, 1000));
+	report("push_back 100k double", push_back_fill<std::vector<double> >(100000, 50), push_back_fill<ft::vector<double> >(100000, 50));
+	report("insert/resize 1M int", resize_insert_fill<std::vector<int> >(1000000, 5), resize_insert_fill<ft::vector<int> >(1000000, 5));
+	report("middle insert/erase int", middle_insert_erase<std::vector<int> >(100000, 20000), middle_insert_erase<ft::vector<int> >(100000, 20000));
+	report("middle insert/erase ptr", middle_insert_erase<std::vector<void*> >(100000, 20000), middle_insert_erase<ft::vector<void*> >(100000, 20000));
+	report("range append 1M int x 20", range_append<std::vector<int> >(1000000, 20), range_append<ft::vector<int> >(1000000, 20));
+
+//  SMALL VECTOR against a heap vector, both counting their allocations
+	size_t vectorAllocations = 0;
+	size_t smallAllocations = 0;
+	double vectorTime = small_fills<ft::vector<int, counting_allocator<int> > >(2000000, vectorAllocations);
+	double smallTime = small_fills<ft::small_vector<int, 8, counting_allocator<int> > >(2000000, smallAllocations);
+
+	std::cout << std::left << std::setw(28) << "" << std::right << std::setw(13) << "ft::vector" << std::setw(13) << "small_vector" << std::endl;
+	report("2M vectors of 0-7 int", vectorTime, smallTime);
+	report_allocations("allocations", vectorAllocations, smallAllocations);
+
+//  MAP node pool against std::map and against the tree without its pool
+	size_t stdAllocations = 0;
+	size_t pooledAllocations = 0;
+	size_t unpooledAllocations = 0;
+	double stdTime = map_churn<std::map<int, int, std::less<int>, counting_allocator<std::pair<const int, int> > > >(100000, 1000000, stdAllocations);
+	double pooledTime = map_churn<ft::map<int, int, ft::less<int>, counting_allocator<ft::pair<const int, int> > > >(100000, 1000000, pooledAllocations);
+	double unpooledTime = map_churn<ft::map<int, int, ft::less<int>, unpooled_allocator<ft::pair<const int, int> > > >(100000, 1000000, unpooledAllocations);
+
+	std::cout << std::left << std::setw(28) << "" << std::right << std::setw(13) << "std::map" << std::setw(13) << "ft::map" << std::endl;
+	report("map churn 100k x 1M", stdTime, pooledTime);
+	report_allocations("allocations", stdAllocations, pooledAllocations);
+	report("map churn without pool", stdTime, unpooledTime);
+	report_allocations("allocations", stdAllocations, unpooledAllocations);
+	report("map [] hits 100k x 2M", map_subscript_hits<std::map<int, int> >(100000, 2000000), map_subscript_hits<ft::map<int, int> >(100000, 2000000));
+	report("string find 10k x 1M", string_lookups<std::map<std::string, std::vector<int> >, std::string>(10000, 1000000), string_lookups<ft::map<std::string, std::vector<int> >, std::string>(10000, 1000000));
+	report("const char* find 10k x 1M", string_lookups<std::map<std::string, std::vector<int> >, const char*>(10000, 1000000), string_lookups<ft::map<std::string, std::vector<int>, ft::less<void> >, const char*>(10000, 1000000));
+	report("hinted sorted 100k x 10", hinted_inserts<std::map<int, int> >(100000, 10, 1), hinted_inserts<ft::map<int, int> >(100000, 10, 1));
+	report("hinted reverse 100k x 10", hinted_inserts<std::map<int, int> >(100000, 10, -1), hinted_inserts<ft::map<int, int> >(100000, 10, -1));
+	report("hinted random 100k x 10", hinted_inserts<std::map<int, int> >(100000, 10, 0), hinted_inserts<ft::map<int, int> >(100000, 10, 0));
+	report("set from sorted 1M x 5", sorted_build<std::set<int>, std::vector<int> >(1000000, 5), sorted_build<ft::set<int>, ft::vector<int> >(1000000, 5));
+	report("union 1M with 1k x 100", small_unions<std::set<int> >(1000000, 1000, 100), small_unions<ft::set<int> >(1000000, 1000, 100));
+	report("split/join 1M x 20", split_joins<std::set<int> >(1000000, 20), split_joins<ft::set<int> >(1000000, 20));
+	report("shard moves 100k x 2M", shard_moves<std::map<int, std::string> >(100000, 2000000), shard_moves<ft::map<int, std::string> >(100000, 2000000));
+	report("map copy/assign 500k x 10", map_snapshots<std::map<int, int> >(500000, 10), map_snapshots<ft::map<int, int> >(500000, 10));
+	report("map scans 1M x 10", map_scans<std::map<int, int> >(1000000, 10), map_scans<ft::map<int, int> >(1000000, 10));
+	report("window expiry 100k x 2k", window_expiry<std::map<int, int> >(100000, 1000, 2000), window_expiry<ft::map<int, int> >(100000, 1000, 2000));
+	std::cout << std::left << std::setw(28) << "ft::set<int> node" << std::right << std::setw(23) << sizeof(ft::node<int>) << " bytes" << std::endl;
+	report("percentiles 100k x 2k", percentiles<std::map<int, int> >(100000, 2000), percentiles<ft::map<int, int> >(100000, 2000));
+	report("map fill/clear 10k x 200", map_fill_clear<std::map<int, int> >(10000, 200), map_fill_clear<ft::map<int, int> >(10000, 200));
+
+//  B-TREE and FLAT MAP against the red-black trees, times in nanoseconds per element and memory in bytes per element
+	typedef byte_counting_allocator<std::pair<const int, int> >	std_bytes;
+	typedef byte_counting_allocator<ft::pair<const int, int> >	ft_bytes;
+	typedef byte_counting_allocator<ft::pair<int, int> >		flat_bytes;
+	typedef std::pair<int, int>									std_pair;
+	typedef ft::pair<int, int>									ft_pair;
+
+	std::cout << std::left << std::setw(28) << "" << std::right << std::setw(13) << "std::map" << std::setw(13) << "ft::map" << std::setw(13) << "btree_map" << std::setw(13) << "flat_map" << std::endl;
+	std::cout << std::left << std::setw(28) << "lookup 1k keys" << std::right << std::fixed << std::setprecision(2)
+		<< std::setw(10) << lookup_ns<std::map<int, int> >(1000, 5000000) << " ns" << std::setw(10) << lookup_ns<ft::map<int, int> >(1000, 5000000) << " ns"
+		<< std::setw(10) << lookup_ns<ft::btree_map<int, int> >(1000, 5000000) << " ns" << std::setw(10) << lookup_ns<ft::flat_map<int, int> >(1000, 5000000) << " ns" << std::endl;
+	std::cout << std::left << std::setw(28) << "lookup 1M keys" << std::right << std::fixed << std::setprecision(2)
+		<< std::setw(10) << lookup_ns<std::map<int, int> >(1000000, 2000000) << " ns" << std::setw(10) << lookup_ns<ft::map<int, int> >(1000000, 2000000) << " ns"
+		<< std::setw(10) << lookup_ns<ft::btree_map<int, int> >(1000000, 2000000) << " ns" << std::setw(10) << lookup_ns<ft::flat_map<int, int> >(1000000, 2000000) << " ns" << std::endl;
+	std::cout << std::left << std::setw(28) << "scan 1M keys x 20" << std::right << std::fixed << std::setprecision(2)
+		<< std::setw(10) << scan_ns<std::map<int, int>, std_pair>(1000000, 20) << " ns" << std::setw(10) << scan_ns<ft::map<int, int>, ft_pair>(1000000, 20) << " ns"
+		<< std::setw(10) << scan_ns<ft::btree_map<int, int>, ft_pair>(1000000, 20) << " ns" << std::setw(10) << scan_ns<ft::flat_map<int, int>, ft_pair>(1000000, 20) << " ns" << std::endl;
+	std::cout << std::left << std::setw(28) << "memory 1M int pairs" << std::right << std::fixed << std::setprecision(2)
+		<< std::setw(10) << bytes_per_element<std::map<int, int, std::less<int>, std_bytes>, std_pair>(1000000) << " B "
+		<< std::setw(10) << bytes_per_element<ft::map<int, int, ft::less<int>, ft_bytes>, ft_pair>(1000000) << " B "
+		<< std::setw(10) << bytes_per_element<ft::btree_map<int, int, ft::less<int>, ft_bytes>, ft_pair>(1000000) << " B "
+		<< std::setw(10) << bytes_per_element<ft::flat_map<int, int, ft::less<int>, flat_bytes>, ft_pair>(1000000) << " B " << std::endl;
+
+//  HASH MAP against the ordered maps, for point lookups
+	std::cout << std::left << std::setw(28) << "" << std::right << std::setw(13) << "std::map" << std::setw(13) << "ft::map" << std::setw(13) << "unordered" << std::endl;
+	std::cout << std::left << std::setw(28) << "find 1k keys" << std::right << std::fixed << std::setprecision(2)
+		<< std::setw(10) << find_ns<std::map<int, int> >(1000, 5000000) << " ns" << std::setw(10) << find_ns<ft::map<int, int> >(1000, 5000000) << " ns"
+		<< std::setw(10) << find_ns<ft::unordered_map<int, int> >(1000, 5000000) << " ns" << std::endl;
+	std::cout << std::left << std::setw(28) << "find 1M keys" << std::right << std::fixed << std::setprecision(2)
+		<< std::setw(10) << find_ns<std::map<int, int> >(1000000, 2000000) << " ns" << std::setw(10) << find_ns<ft::map<int, int> >(1000000, 2000000) << " ns"
+		<< std::setw(10) << find_ns<ft::unordered_map<int, int> >(1000000, 2000000) << " ns" << std::endl;
+	std::cout << std::left << std::setw(28) << "[] hits 100k x 2M" << std::right << std::fixed << std::setprecision(2)
+		<< std::setw(10) << map_subscript_hits<std::map<int, int> >(100000, 2000000) << " ms" << std::setw(10) << map_subscript_hits<ft::map<int, int> >(100000, 2000000) << " ms"
+		<< std::setw(10) << map_subscript_hits<ft::unordered_map<int, int> >(100000, 2000000) << " ms" << std::endl;
+	std::cout << std::left << std::setw(28) << "erase/insert 100k x 1M" << std::right << std::fixed << std::setprecision(2)
+		<< std::setw(10) << point_churn<std::map<int, int> >(100000, 1000000) << " ms" << std::setw(10) << point_churn<ft::map<int, int> >(100000, 1000000) << " ms"
+		<< std::setw(10) << point_churn<ft::unordered_map<int, int> >(100000, 1000000) << " ms" << std::endl;
+
+//  MAP with per-thread node caches, wall time for the same work per thread
+	typedef threaded_churn<std::map<int, int> >																		std_churn;
+	typedef threaded_churn<ft::map<int, int> >																		pool_churn;
+	typedef threaded_churn<ft::map<int, int, ft::less<int>, ft::thread_cache_allocator<ft::pair<const int, int> > > >	cache_churn;
+
+	std::cout << std::left << std::setw(28) << "" << std::right << std::setw(13) << "std::map" << std::setw(13) << "ft::map" << std::setw(13) << "thread_cache" << std::endl;
+	for (size_t threads = 1; threads <= 16; threads *= 2) {
+		std::ostringstream name;
+		name << "churn " << threads << (threads == 1 ? " thread" : " threads");
+		std::cout << std::left << std::setw(28) << name.str() << std::right << std::fixed << std::setprecision(2)
+			<< std::setw(10) << std_churn::run(threads) << " ms" << std::setw(10) << pool_churn::run(threads) << " ms"
+			<< std::setw(10) << cache_churn::run(threads) << " ms" << std::endl;
+	}
+
+//  CONCURRENT MAP against one lock around one map, wall time for the same read/write mix per thread
+	typedef ft::concurrent_map<int, int>	sharded_map;
+
+	std::cout << std::left << std::setw(28) << "" << std::right << std::setw(13) << "one mutex" << std::setw(13) << "one rwlock" << std::setw(13) << "16 shards" << std::endl;
+	for (size_t threads = 1; threads <= 16; threads *= 2) {
+		std::ostringstream name;
+		mutex_map locked;
+		sharded_map single(1);
+		sharded_map sharded(16);
+		name << "90% reads " << threads << (threads == 1 ? " thread" : " threads");
+		std::cout << std::left << std::setw(28) << name.str() << std::right << std::fixed << std::setprecision(2)
+			<< std::setw(10) << threaded_mix<mutex_map>::run(locked, threads) << " ms" << std::setw(10) << threaded_mix<sharded_map>::run(single, threads) << " ms"
+			<< std::setw(10) << threaded_mix<sharded_map>::run(sharded, threads) << " ms" << std::endl;
+	}
+
+//  PERSISTENT MAP against publishing every version as a copy
+	std::cout << std::left << std::setw(28) << "" << std::right << std::setw(13) << "std::map" << std::setw(13) << "ft::map" << std::setw(13) << "persistent" << std::endl;
+	std::cout << std::left << std::setw(28) << "publish 100k x 200" << std::right << std::fixed << std::setprecision(2)
+		<< std::setw(10) << copied_versions<std::map<int, int> >(100000, 200) << " ms" << std::setw(10) << copied_versions<ft::map<int, int> >(100000, 200) << " ms"
+		<< std::setw(10) << persistent_versions(100000, 200) << " ms" << std::endl;
+	std::cout << std::left << std::setw(28) << "find in version 100k" << std::right << std::fixed << std::setprecision(2)
+		<< std::setw(10) << version_find_ns<std::map<int, int> >(100000, 2000000) << " ns" << std::setw(10) << version_find_ns<ft::map<int, int> >(100000, 2000000) << " ns"
+		<< std::setw(10) << version_find_ns<ft::persistent_map<int, int> >(100000, 2000000) << " ns" << std::endl;
+	return 0;
+}
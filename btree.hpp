@@ -0,0 +1,715 @@
+#pragma once
+
+#include <memory>
+#include <cstring>
+#include "utils.hpp"
+#include "pair.hpp"
+
+namespace ft {
+//	Node of a B-tree: up to slots values in order, an internal node also has count + 1 children around them.
+//	Nodes are sized to about node_bytes, a few cache lines, so a lookup reads a handful of wide nodes instead of one small node per level.
+    template <class Value>
+    struct btree_node {
+        static const size_t	node_bytes = 256;
+        static const size_t	fit = (node_bytes - sizeof(void*) * 2) / sizeof(Value);
+        static const size_t	slots = fit < 3 ? 3 : (fit > 255 ? 255 : fit);
+
+        btree_node*		parent;
+        unsigned short	position;
+        unsigned short	count;
+        bool			leaf;
+        union {
+            char		bytes[sizeof(Value) * slots];
+            long double	align_float;
+            long		align_int;
+            void*		align_pointer;
+        }				storage;
+
+        Value& value(size_t i) {
+            return reinterpret_cast<Value*>(storage.bytes)[i];
+        }
+
+        btree_node*& child(size_t i);
+    };
+
+    template <class Value>
+    struct btree_internal : public btree_node<Value> {
+        btree_node<Value>*	children[btree_node<Value>::slots + 1];
+    };
+
+    template <class Value>
+    btree_node<Value>*& btree_node<Value>::child(size_t i) {
+        return static_cast<btree_internal<Value>*>(this)->children[i];
+    }
+
+//	A value is a node and a slot. end() is one past the last slot of the rightmost leaf.
+//	Inserting or erasing may move values between nodes, so unlike ft::map both invalidate iterators.
+    template <class T>
+    class btree_iterator {
+    public:
+        typedef std::ptrdiff_t											difference_type;
+        typedef T														value_type;
+        typedef T*														pointer;
+        typedef T&														reference;
+        typedef ft::btree_node<typename ft::switch_const<T>::type>*	node_ptr;
+        typedef std::bidirectional_iterator_tag							iterator_category;
+    private:
+        node_ptr	_node;
+        size_t		_pos;
+    public:
+        btree_iterator() : _node(0), _pos(0) {}
+
+        btree_iterator(node_ptr node, size_t pos) : _node(node), _pos(pos) {}
+
+        btree_iterator(const btree_iterator& other) : _node(other._node), _pos(other._pos) {}
+
+        ~btree_iterator() {}
+
+        btree_iterator& operator=(const btree_iterator& other) {
+            _node = other._node;
+            _pos = other._pos;
+            return *this;
+        }
+
+        template <class Type>
+        operator btree_iterator<const Type>() const {
+            return btree_iterator<const Type>(_node, _pos);
+        }
+
+        reference operator*() const {
+            return _node->value(_pos);
+        }
+
+        pointer operator->() const {
+            return &_node->value(_pos);
+        }
+
+        node_ptr node() const {
+            return _node;
+        }
+
+        size_t position() const {
+            return _pos;
+        }
+
+//		After an internal value comes the first value of the subtree to its right.
+//		Past the last value of a leaf the climb stops at the first parent with a value left, from the last leaf it finds none and stays at end().
+        btree_iterator& operator++() {
+            if (!_node->leaf) {
+                _node = _node->child(_pos + 1);
+                while (!_node->leaf)
+                    _node = _node->child(0);
+                _pos = 0;
+                return *this;
+            }
+            if (++_pos < _node->count)
+                return *this;
+            node_ptr node = _node;
+            size_t pos = _pos;
+            while (pos == node->count && node->parent) {
+                pos = node->position;
+                node = node->parent;
+            }
+            if (pos < node->count) {
+                _node = node;
+                _pos = pos;
+            }
+            return *this;
+        }
+
+        btree_iterator operator++(int) {
+            btree_iterator tmp(*this);
+            ++(*this);
+            return tmp;
+        }
+
+        btree_iterator& operator--() {
+            if (!_node->leaf) {
+                _node = _node->child(_pos);
+                while (!_node->leaf)
+                    _node = _node->child(_node->count);
+                _pos = _node->count - 1;
+                return *this;
+            }
+            if (_pos > 0) {
+                --_pos;
+                return *this;
+            }
+            node_ptr node = _node;
+            size_t pos = 0;
+            while (pos == 0 && node->parent) {
+                pos = node->position;
+                node = node->parent;
+            }
+            if (pos > 0) {
+                _node = node;
+                _pos = pos - 1;
+            }
+            return *this;
+        }
+
+        btree_iterator operator--(int) {
+            btree_iterator tmp(*this);
+            --(*this);
+            return tmp;
+        }
+    };
+
+    template <class Iterator1, class Iterator2>
+    bool operator==(const btree_iterator<Iterator1>& a, const btree_iterator<Iterator2>& b) {
+        return a.node() == b.node() && a.position() == b.position();
+    }
+
+    template <class Iterator1, class Iterator2>
+    bool operator!=(const btree_iterator<Iterator1>& a, const btree_iterator<Iterator2>& b) {
+        return !(a == b);
+    }
+
+//	B-tree of unique values, the engine of btree_map and btree_set.
+//	Every node but the root holds between min_count and slots values. A full node is split around its middle value, which moves up into the parent.
+//	A node that falls under min_count borrows a value through the parent from a sibling that can spare one, or is merged with a sibling and their separator.
+//	Values move slot to slot with memmove when they are trivially relocatable, and are moved (C++11 and later, when that cannot throw) or copied otherwise.
+//	Nodes are allocated and the inserted value is copied before anything moves, so when relocating cannot throw an insert or an erase either succeeds or leaves the tree as it was.
+//	A copy that throws while values are being relocated, possible before C++11 for types such as std::string, leaves the tree in an unspecified state.
+    template <class Value, class Compare, class Alloc = std::allocator<Value> >
+    class BTree {
+    public:
+        typedef ft::btree_node<Value>		node_type;
+        typedef node_type*					node_ptr;
+        typedef ft::btree_iterator<Value>	iterator;
+        typedef Alloc						allocator_type;
+    private:
+        typedef ft::btree_internal<Value>										internal_type;
+        typedef typename Alloc::template rebind<node_type>::other				leaf_allocator;
+        typedef typename Alloc::template rebind<internal_type>::other			internal_allocator;
+
+        static const size_t	slots = node_type::slots;
+        static const size_t	min_count = (slots - 1) / 2;
+
+        typedef ft::integral_constant<bool, ft::is_trivially_relocatable<Value>::value> relocatable;
+
+        allocator_type	_alloc;
+        Compare			_compare;
+        node_ptr		_root;
+        node_ptr		_leftmost;
+        node_ptr		_rightmost;
+        size_t			_size;
+
+        BTree(const BTree&);
+        BTree& operator=(const BTree&);
+
+        node_ptr create_node(bool leaf, node_ptr parent, size_t pos) {
+            node_ptr some;
+
+            if (leaf)
+                some = leaf_allocator(_alloc).allocate(1);
+            else {
+                internal_type* internal = internal_allocator(_alloc).allocate(1);
+                for (size_t i = 0; i <= slots; ++i)
+                    internal->children[i] = 0;
+                some = internal;
+            }
+            some->parent = parent;
+            some->position = static_cast<unsigned short>(pos);
+            some->count = 0;
+            some->leaf = leaf;
+            return some;
+        }
+
+        void free_node(node_ptr some) {
+            if (some->leaf)
+                leaf_allocator(_alloc).deallocate(some, 1);
+            else
+                internal_allocator(_alloc).deallocate(static_cast<internal_type*>(some), 1);
+        }
+
+//		Destroys the values and the children that are there, a node copied halfway included.
+        void destroy(node_ptr some) {
+            if (!some->leaf) {
+                for (size_t i = 0; i <= some->count; ++i) {
+                    if (some->child(i))
+                        destroy(some->child(i));
+                }
+            }
+            for (size_t i = 0; i < some->count; ++i)
+                _alloc.destroy(&some->value(i));
+            free_node(some);
+        }
+
+        node_ptr copy(node_ptr source, node_ptr parent) {
+            node_ptr some = create_node(source->leaf, parent, source->position);
+
+            try {
+                for (size_t i = 0; i < source->count; ++i) {
+                    if (!source->leaf)
+                        some->child(i) = copy(source->child(i), some);
+                    _alloc.construct(&some->value(i), source->value(i));
+                    ++some->count;
+                }
+                if (!source->leaf)
+                    some->child(some->count) = copy(source->child(source->count), some);
+            } catch (...) {
+                destroy(some);
+                throw;
+            }
+            return some;
+        }
+
+//		Moves n values from slot j of from to slot i of to, the two ranges may overlap inside one node.
+        void relocate(node_ptr to, size_t i, node_ptr from, size_t j, size_t n = 1) {
+            if (n)
+                relocate(&to->value(i), &from->value(j), n, relocatable());
+        }
+
+        void relocate(Value* dst, Value* src, size_t n, ft::true_type) {
+            std::memmove(static_cast<void*>(dst), static_cast<const void*>(src), n * sizeof(Value));
+        }
+
+        void relocate(Value* dst, Value* src, size_t n, ft::false_type) {
+            if (dst < src) {
+                for (size_t i = 0; i < n; ++i) {
+                    _alloc.construct(dst + i, ft::move_if_noexcept(src[i]));
+                    _alloc.destroy(src + i);
+                }
+            }
+            else {
+                for (size_t i = n; i > 0; --i) {
+                    _alloc.construct(dst + i - 1, ft::move_if_noexcept(src[i - 1]));
+                    _alloc.destroy(src + i - 1);
+                }
+            }
+        }
+
+        void set_child(node_ptr parent, size_t i, node_ptr some) {
+            parent->child(i) = some;
+            some->parent = parent;
+            some->position = static_cast<unsigned short>(i);
+        }
+
+        void update_extremes() {
+            _leftmost = _root;
+            _rightmost = _root;
+            if (_root) {
+                while (!_leftmost->leaf)
+                    _leftmost = _leftmost->child(0);
+                while (!_rightmost->leaf)
+                    _rightmost = _rightmost->child(_rightmost->count);
+            }
+        }
+
+//		Index of the first value of some not less than key, by binary search over the slots.
+        template <class K>
+        size_t lower_index(node_ptr some, const K& key) const {
+            size_t low = 0;
+            size_t high = some->count;
+
+            while (low < high) {
+                size_t mid = (low + high) / 2;
+                if (_compare(some->value(mid), key))
+                    low = mid + 1;
+                else
+                    high = mid;
+            }
+            return low;
+        }
+
+        template <class K>
+        size_t upper_index(node_ptr some, const K& key) const {
+            size_t low = 0;
+            size_t high = some->count;
+
+            while (low < high) {
+                size_t mid = (low + high) / 2;
+                if (_compare(key, some->value(mid)))
+                    high = mid;
+                else
+                    low = mid + 1;
+            }
+            return low;
+        }
+
+//		Splits the full node some around its middle value, which goes up into the parent, splitting a full parent first.
+//		some keeps the lower half, the upper half moves to a new right sibling.
+        void split(node_ptr some) {
+            if (some->parent && some->parent->count == slots)
+                split(some->parent);
+            node_ptr right = create_node(some->leaf, 0, 0);
+            node_ptr parent = some->parent;
+            if (!parent) {
+                try {
+                    parent = create_node(false, 0, 0);
+                } catch (...) {
+                    free_node(right);
+                    throw;
+                }
+                set_child(parent, 0, some);
+                _root = parent;
+            }
+            size_t mid = slots / 2;
+            size_t k = some->position;
+
+            relocate(right, 0, some, mid + 1, some->count - mid - 1);
+            if (!some->leaf) {
+                for (size_t j = mid + 1; j <= some->count; ++j)
+                    set_child(right, j - mid - 1, some->child(j));
+            }
+            right->count = static_cast<unsigned short>(some->count - mid - 1);
+            relocate(parent, k + 1, parent, k, parent->count - k);
+            for (size_t j = parent->count; j > k; --j)
+                set_child(parent, j + 1, parent->child(j));
+            relocate(parent, k, some, mid);
+            set_child(parent, k + 1, right);
+            ++parent->count;
+            some->count = static_cast<unsigned short>(mid);
+            if (_rightmost == some)
+                _rightmost = right;
+        }
+
+//		Inserts val at slot i of the leaf some, splitting it first when it is full.
+        iterator insert_at(node_ptr some, size_t i, const Value& val) {
+            if (some->count == slots) {
+                split(some);
+                if (i > some->count) {
+                    i -= some->count + 1;
+                    some = some->parent->child(some->position + 1);
+                }
+            }
+            relocate(some, i + 1, some, i, some->count - i);
+            try {
+                _alloc.construct(&some->value(i), val);
+            } catch (...) {
+                relocate(some, i, some, i + 1, some->count - i);
+                throw;
+            }
+            ++some->count;
+            ++_size;
+            return iterator(some, i);
+        }
+
+//		some takes the separator on its left from the parent, which takes the last value of the left sibling in exchange.
+        void borrow_left(node_ptr some) {
+            node_ptr parent = some->parent;
+            size_t k = some->position;
+            node_ptr left = parent->child(k - 1);
+
+            relocate(some, 1, some, 0, some->count);
+            if (!some->leaf) {
+                for (size_t j = some->count + 1; j > 0; --j)
+                    set_child(some, j, some->child(j - 1));
+                set_child(some, 0, left->child(left->count));
+            }
+            relocate(some, 0, parent, k - 1);
+            relocate(parent, k - 1, left, left->count - 1);
+            --left->count;
+            ++some->count;
+        }
+
+        void borrow_right(node_ptr some) {
+            node_ptr parent = some->parent;
+            size_t k = some->position;
+            node_ptr right = parent->child(k + 1);
+
+            relocate(some, some->count, parent, k);
+            relocate(parent, k, right, 0);
+            if (!some->leaf)
+                set_child(some, some->count + 1, right->child(0));
+            relocate(right, 0, right, 1, right->count - 1);
+            if (!right->leaf) {
+                for (size_t j = 1; j <= right->count; ++j)
+                    set_child(right, j - 1, right->child(j));
+            }
+            --right->count;
+            ++some->count;
+        }
+
+//		Appends the separator after left and its right sibling to left, then frees the sibling.
+        void merge(node_ptr left) {
+            node_ptr parent = left->parent;
+            size_t k = left->position;
+            node_ptr right = parent->child(k + 1);
+
+            relocate(left, left->count, parent, k);
+            relocate(left, left->count + 1, right, 0, right->count);
+            if (!left->leaf) {
+                for (size_t j = 0; j <= right->count; ++j)
+                    set_child(left, left->count + 1 + j, right->child(j));
+            }
+            left->count = static_cast<unsigned short>(left->count + right->count + 1);
+            relocate(parent, k, parent, k + 1, parent->count - k - 1);
+            for (size_t j = k + 1; j < parent->count; ++j)
+                set_child(parent, j, parent->child(j + 1));
+            --parent->count;
+            free_node(right);
+        }
+
+//		Walks up from a leaf that may have fallen under min_count, an emptied root gives way to its only child.
+//		pos is a slot of the leaf, or its count for whatever follows its last value: the same place is returned in the rebalanced tree.
+        iterator rebalance(node_ptr some, size_t pos) {
+            node_ptr leaf = some;
+
+            while (some != _root && some->count < min_count) {
+                node_ptr parent = some->parent;
+                size_t k = some->position;
+                node_ptr left = k > 0 ? parent->child(k - 1) : 0;
+                node_ptr right = k < parent->count ? parent->child(k + 1) : 0;
+
+                if (left && left->count > min_count) {
+                    pos += some == leaf;
+                    borrow_left(some);
+                    break;
+                }
+                if (right && right->count > min_count) {
+                    borrow_right(some);
+                    break;
+                }
+                if (left && some == leaf) {
+                    pos += left->count + 1;
+                    leaf = left;
+                }
+                merge(left ? left : some);
+                some = parent;
+            }
+            if (!_root->count) {
+                node_ptr old = _root;
+                _root = old->leaf ? 0 : old->child(0);
+                if (_root) {
+                    _root->parent = 0;
+                    _root->position = 0;
+                }
+                free_node(old);
+            }
+            update_extremes();
+            if (!_root)
+                return end();
+            while (pos == leaf->count && leaf->parent) {
+                pos = leaf->position;
+                leaf = leaf->parent;
+            }
+            if (pos == leaf->count)
+                return end();
+            return iterator(leaf, pos);
+        }
+
+        iterator insert_root(const Value& val) {
+            _root = create_node(true, 0, 0);
+            update_extremes();
+            try {
+                return insert_at(_root, 0, val);
+            } catch (...) {
+                free_node(_root);
+                _root = 0;
+                update_extremes();
+                throw;
+            }
+        }
+
+    public:
+        explicit BTree(const allocator_type& alloc = allocator_type(), const Compare& compare = Compare()) : _alloc(alloc), _compare(compare), _root(0), _leftmost(0), _rightmost(0), _size(0) {}
+
+        ~BTree() {
+            clear();
+        }
+
+        allocator_type get_allocator() const {
+            return _alloc;
+        }
+
+        size_t size() const {
+            return _size;
+        }
+
+        size_t max_size() const {
+            return _alloc.max_size();
+        }
+
+        iterator begin() const {
+            return iterator(_leftmost, 0);
+        }
+
+        iterator end() const {
+            return iterator(_rightmost, _rightmost ? _rightmost->count : 0);
+        }
+
+        void clear() {
+            if (_root)
+                destroy(_root);
+            _root = 0;
+            _leftmost = 0;
+            _rightmost = 0;
+            _size = 0;
+        }
+
+//		Copies the shape of other node by node, the comparator comes along.
+        void assign(const BTree& other) {
+            clear();
+            if (other._root)
+                _root = copy(other._root, 0);
+            update_extremes();
+            _size = other._size;
+            _compare = other._compare;
+        }
+
+        void swap(BTree& other) {
+            allocator_type alloc = _alloc;
+            Compare compare = _compare;
+            node_ptr root = _root;
+            node_ptr leftmost = _leftmost;
+            node_ptr rightmost = _rightmost;
+            size_t size = _size;
+            _alloc = other._alloc;
+            _compare = other._compare;
+            _root = other._root;
+            _leftmost = other._leftmost;
+            _rightmost = other._rightmost;
+            _size = other._size;
+            other._alloc = alloc;
+            other._compare = compare;
+            other._root = root;
+            other._leftmost = leftmost;
+            other._rightmost = rightmost;
+            other._size = size;
+        }
+
+        template <class K>
+        iterator find(const K& key) const {
+            node_ptr some = _root;
+
+            while (some) {
+                size_t i = lower_index(some, key);
+                if (i < some->count && !_compare(key, some->value(i)))
+                    return iterator(some, i);
+                if (some->leaf)
+                    break;
+                some = some->child(i);
+            }
+            return end();
+        }
+
+//		The last candidate met on the way down wins, the deeper ones are smaller.
+        template <class K>
+        iterator lower_bound(const K& key) const {
+            iterator res = end();
+            node_ptr some = _root;
+
+            while (some) {
+                size_t i = lower_index(some, key);
+                if (i < some->count)
+                    res = iterator(some, i);
+                if (some->leaf)
+                    break;
+                some = some->child(i);
+            }
+            return res;
+        }
+
+        template <class K>
+        iterator upper_bound(const K& key) const {
+            iterator res = end();
+            node_ptr some = _root;
+
+            while (some) {
+                size_t i = upper_index(some, key);
+                if (i < some->count)
+                    res = iterator(some, i);
+                if (some->leaf)
+                    break;
+                some = some->child(i);
+            }
+            return res;
+        }
+
+        ft::pair<iterator, bool> insert(const Value& val) {
+            if (!_root)
+                return ft::pair<iterator, bool>(insert_root(val), true);
+            node_ptr some = _root;
+            for (;;) {
+                size_t i = lower_index(some, val);
+                if (i < some->count && !_compare(val, some->value(i)))
+                    return ft::pair<iterator, bool>(iterator(some, i), false);
+                if (some->leaf)
+                    return ft::pair<iterator, bool>(insert_at(some, i, val), true);
+                some = some->child(i);
+            }
+        }
+
+//		Inserts val right before hint without a comparison, the caller knows it belongs there: O(1) amortized.
+//		A value goes into a leaf: before an internal value that is right after its predecessor, the last value of a leaf.
+        iterator insert_before(iterator hint, const Value& val) {
+            if (!_root)
+                return insert_root(val);
+            if (hint.node()->leaf)
+                return insert_at(hint.node(), hint.position(), val);
+            --hint;
+            return insert_at(hint.node(), hint.position() + 1, val);
+        }
+
+//		Inserts right before hint when val belongs there, so appending at end() is O(1) amortized, otherwise descends from the root.
+        ft::pair<iterator, bool> insert(iterator hint, const Value& val) {
+            if (_root) {
+                if (hint == end() || _compare(val, *hint)) {
+                    iterator before = hint;
+                    if (hint == begin() || _compare(*(--before), val))
+                        return ft::pair<iterator, bool>(insert_before(hint, val), true);
+                }
+                else if (!_compare(*hint, val))
+                    return ft::pair<iterator, bool>(hint, false);
+            }
+            return insert(val);
+        }
+
+//		A value of an internal node is replaced by its predecessor, the last value of a leaf, so values always leave from leaves.
+//		Returns the value that came after the erased one, followed through the rebalance since values may have moved.
+        iterator erase(iterator where) {
+            node_ptr some = where.node();
+            size_t i = where.position();
+            bool internal = !some->leaf;
+
+            _alloc.destroy(&some->value(i));
+            if (internal) {
+                node_ptr leaf = some->child(i);
+                while (!leaf->leaf)
+                    leaf = leaf->child(leaf->count);
+                relocate(some, i, leaf, leaf->count - 1);
+                some = leaf;
+                i = leaf->count - 1;
+            }
+            else
+                relocate(some, i, some, i + 1, some->count - i - 1);
+            --some->count;
+            --_size;
+            iterator next = rebalance(some, i);
+            if (internal)
+                ++next;
+            return next;
+        }
+
+//		[first, last) must be sorted without duplicates and come after every value here.
+        template <class InputIterator>
+        void append(InputIterator first, InputIterator last) {
+            for (; first != last; ++first)
+                insert_before(end(), *first);
+        }
+
+        template <class K>
+        size_t erase(const K& key) {
+            iterator where = find(key);
+
+            if (where == end())
+                return 0;
+            erase(where);
+            return 1;
+        }
+
+//		Erasing moves values between nodes, so a range goes from its back: n times the value right before the first one not less than key.
+        template <class K>
+        void erase_before(const K& key, size_t n) {
+            while (n--)
+                erase(--lower_bound(key));
+        }
+
+        void erase_back(size_t n) {
+            while (n--)
+                erase(--end());
+        }
+    };
+}
@@ -0,0 +1,318 @@
+#pragma once
+
+#include "iterator.hpp"
+#include "utils.hpp"
+#include "btree.hpp"
+
+namespace ft {
+//	ft::set on a B-tree: same interface, keys packed many to a node so lookups and scans touch fewer cache lines.
+//	Inserting or erasing invalidates every iterator, and there are no node handles, set algebra or order statistics.
+    template <class Key, class Compare = ft::less<Key>, class Alloc = std::allocator<Key> >
+    class btree_set {
+    public:
+        typedef Key										key_type;
+        typedef key_type								value_type;
+        typedef size_t									size_type;
+        typedef Compare									key_compare;
+        typedef key_compare								value_compare;
+        typedef Alloc									allocator_type;
+        typedef value_type&								reference;
+        typedef const value_type&						const_reference;
+        typedef typename allocator_type::pointer		pointer;
+        typedef typename allocator_type::const_pointer	const_pointer;
+        typedef std::ptrdiff_t							difference_type;
+        typedef ft::btree_iterator<const value_type>	iterator;
+        typedef ft::btree_iterator<const value_type>	const_iterator;
+        typedef ft::reverse_iterator<iterator>			reverse_iterator;
+        typedef ft::reverse_iterator<const_iterator>	const_reverse_iterator;
+    private:
+        typedef ft::BTree<value_type, value_compare, Alloc>	tree_type;
+
+        tree_type		_tree;
+        allocator_type	_alloc;
+        key_compare		_k_comp;
+
+//		Return type R for lookups by a key of type K, only when Compare is transparent.
+        template <class K, class R>
+        struct enable_if_transparent : public ft::enable_if<ft::is_transparent<Compare>::value, R> {};
+
+//		The tree hands out mutable iterators, a set only const ones.
+        static typename tree_type::iterator unconst(const_iterator it) {
+            return typename tree_type::iterator(it.node(), it.position());
+        }
+    public:
+        explicit btree_set(const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type()) : _tree(alloc, comp), _alloc(alloc), _k_comp(comp) {}
+
+        template <class InputIterator>
+        btree_set(InputIterator first, InputIterator last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type()) : _tree(alloc, comp), _alloc(alloc), _k_comp(comp) {
+            insert(first, last);
+        }
+
+//		[first, last) must be sorted without duplicates, every key is then appended at end() without a search.
+        template <class InputIterator>
+        btree_set(ft::sorted_unique_t, InputIterator first, InputIterator last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type()) : _tree(alloc, comp), _alloc(alloc), _k_comp(comp) {
+            insert(ft::sorted_unique, first, last);
+        }
+
+        ~btree_set() {}
+
+        btree_set(const btree_set& other) : _tree(other._alloc, other._k_comp), _alloc(other._alloc), _k_comp(other._k_comp) {
+            *this = other;
+        }
+
+        btree_set& operator=(const btree_set& other) {
+            if (this != &other) {
+                _tree.assign(other._tree);
+                _alloc = other._alloc;
+                _k_comp = other._k_comp;
+            }
+            return *this;
+        }
+
+	//	************ iterators *************
+
+        iterator begin() {
+            return _tree.begin();
+        }
+
+        const_iterator begin() const {
+            return _tree.begin();
+        }
+
+        iterator end() {
+            return _tree.end();
+        }
+
+        const_iterator end() const {
+            return _tree.end();
+        }
+
+        reverse_iterator rbegin() {
+            return reverse_iterator(end());
+        }
+
+        const_reverse_iterator rbegin() const {
+            return const_reverse_iterator(end());
+        }
+
+        reverse_iterator rend() {
+            return reverse_iterator(begin());
+        }
+
+        const_reverse_iterator rend() const {
+            return const_reverse_iterator(begin());
+        }
+
+        bool empty() const {
+            return _tree.size() == 0;
+        }
+
+        size_type size() const {
+            return _tree.size();
+        }
+
+        size_type max_size() const {
+            return _tree.max_size();
+        }
+
+	//	************ funcs **********
+
+        ft::pair<iterator, bool> insert(const value_type& val) {
+            return _tree.insert(val);
+        }
+
+        iterator insert(iterator position, const value_type& val) {
+            return _tree.insert(unconst(position), val).first;
+        }
+
+        template <class InputIterator>
+        void insert(InputIterator first, InputIterator last) {
+            for (; first != last; ++first)
+                _tree.insert(_tree.end(), *first);
+        }
+
+//		A promised range that starts after the last key here is appended without a single comparison, any other one is inserted at end() as usual.
+        template <class InputIterator>
+        void insert(ft::sorted_unique_t, InputIterator first, InputIterator last) {
+            if (first != last && !empty() && !_k_comp(*(--end()), *first))
+                insert(first, last);
+            else
+                _tree.append(first, last);
+        }
+
+//		Returns the key that followed the erased one.
+        iterator erase(iterator position) {
+            return _tree.erase(unconst(position));
+        }
+
+        size_type erase(const key_type& k) {
+            return _tree.erase(k);
+        }
+
+        template <class K>
+        typename enable_if_transparent<K, size_type>::type erase(const K& k) {
+            return _tree.erase(k);
+        }
+
+//		Erasing moves values between nodes, so the range is erased from its back, found again by the key of last every time.
+        void erase(iterator first, iterator last) {
+            size_type n = ft::distance(first, last);
+
+            if (n == size())
+                clear();
+            else if (last == end())
+                _tree.erase_back(n);
+            else {
+                key_type bound = *last;
+                _tree.erase_before(bound, n);
+            }
+        }
+
+        void swap(btree_set& x) {
+            allocator_type alloc = _alloc;
+            key_compare key = _k_comp;
+            _tree.swap(x._tree);
+            _alloc = x._alloc;
+            _k_comp = x._k_comp;
+            x._alloc = alloc;
+            x._k_comp = key;
+        }
+
+        void clear() {
+            _tree.clear();
+        }
+
+        key_compare key_comp() const {
+            return _k_comp;
+        }
+
+        value_compare value_comp() const {
+            return _k_comp;
+        }
+
+        iterator find(const key_type& k) {
+            return _tree.find(k);
+        }
+
+        const_iterator find(const key_type& k) const {
+            return _tree.find(k);
+        }
+
+        size_type count(const key_type& k) const {
+            if (_tree.find(k) != _tree.end())
+                return 1;
+            return 0;
+        }
+
+        iterator lower_bound(const key_type& k) {
+            return _tree.lower_bound(k);
+        }
+
+        const_iterator lower_bound(const key_type& k) const {
+            return _tree.lower_bound(k);
+        }
+
+        iterator upper_bound(const key_type& k) {
+            return _tree.upper_bound(k);
+        }
+
+        const_iterator upper_bound(const key_type& k) const {
+            return _tree.upper_bound(k);
+        }
+
+        ft::pair <iterator, iterator> equal_range(const key_type& k) {
+            return ft::make_pair(lower_bound(k), upper_bound(k));
+        }
+
+        ft::pair <const_iterator, const_iterator> equal_range(const key_type& k) const {
+            return ft::make_pair(lower_bound(k), upper_bound(k));
+        }
+
+//		Heterogeneous lookup with a transparent Compare such as ft::less<void>.
+        template <class K>
+        typename enable_if_transparent<K, iterator>::type find(const K& k) {
+            return _tree.find(k);
+        }
+
+        template <class K>
+        typename enable_if_transparent<K, const_iterator>::type find(const K& k) const {
+            return _tree.find(k);
+        }
+
+        template <class K>
+        typename enable_if_transparent<K, size_type>::type count(const K& k) const {
+            if (_tree.find(k) != _tree.end())
+                return 1;
+            return 0;
+        }
+
+        template <class K>
+        typename enable_if_transparent<K, iterator>::type lower_bound(const K& k) {
+            return _tree.lower_bound(k);
+        }
+
+        template <class K>
+        typename enable_if_transparent<K, const_iterator>::type lower_bound(const K& k) const {
+            return _tree.lower_bound(k);
+        }
+
+        template <class K>
+        typename enable_if_transparent<K, iterator>::type upper_bound(const K& k) {
+            return _tree.upper_bound(k);
+        }
+
+        template <class K>
+        typename enable_if_transparent<K, const_iterator>::type upper_bound(const K& k) const {
+            return _tree.upper_bound(k);
+        }
+
+        template <class K>
+        typename enable_if_transparent<K, ft::pair<iterator, iterator> >::type equal_range(const K& k) {
+            return ft::make_pair(lower_bound(k), upper_bound(k));
+        }
+
+        template <class K>
+        typename enable_if_transparent<K, ft::pair<const_iterator, const_iterator> >::type equal_range(const K& k) const {
+            return ft::make_pair(lower_bound(k), upper_bound(k));
+        }
+
+        allocator_type get_allocator() const {
+            return _alloc;
+        }
+    };
+
+    template <class Key, class Compare, class Allocator>
+    bool operator==(const btree_set<Key, Compare, Allocator>& x, const btree_set<Key, Compare, Allocator>& y) {
+        return x.size() == y.size() && ft::equal(x.begin(), x.end(), y.begin());
+    }
+
+    template <class Key, class Compare, class Allocator>
+    bool operator!=(const btree_set<Key, Compare, Allocator>& x, const btree_set<Key, Compare, Allocator>& y) {
+        return !(x == y);
+    }
+
+    template <class Key, class Compare, class Allocator>
+    bool operator<(const btree_set<Key, Compare, Allocator>& x, const btree_set<Key, Compare, Allocator>& y) {
+        return ft::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
+    }
+
+    template <class Key, class Compare, class Allocator>
+    bool operator<=(const btree_set<Key, Compare, Allocator>& x, const btree_set<Key, Compare, Allocator>& y) {
+        return !(y < x);
+    }
+
+    template <class Key, class Compare, class Allocator>
+    bool operator>(const btree_set<Key, Compare, Allocator>& x, const btree_set<Key, Compare, Allocator>& y) {
+        return y < x;
+    }
+
+    template <class Key, class Compare, class Allocator>
+    bool operator>=(const btree_set<Key, Compare, Allocator>& x, const btree_set<Key, Compare, Allocator>& y) {
+        return !(x < y);
+    }
+
+    template <class Key, class Compare, class Allocator>
+    void swap(btree_set<Key, Compare, Allocator>& x, btree_set<Key, Compare, Allocator>& y) {
+        x.swap(y);
+    }
+}
@@ -0,0 +1,257 @@
+#pragma once
+
+#include <new>
+#include <pthread.h>
+#include "utils.hpp"
+#include "map.hpp"
+#include "vector.hpp"
+#include "hash_table.hpp"
+
+namespace ft {
+//	Ordered map shared by many threads: keys are spread by hash over N ft::map shards, each behind its own reader-writer lock.
+//	A point operation takes the lock of one shard only, shared for reads and exclusive for writes, so threads working on different shards never wait.
+//	Lookups hand out copies rather than iterators, which would outlive the lock.
+//	for_each_in_range() read-locks every shard for the whole scan and merges them in key order: it sees one consistent state of the map.
+//	Locks are always taken in shard order, so a scan and the writers cannot deadlock.
+    template <class Key, class T, class Compare = ft::less<Key>, class Hash = ft::hash<Key>, class Alloc = std::allocator <ft::pair<const Key, T> > >
+    class concurrent_map {
+    public:
+        typedef Key									key_type;
+        typedef T									mapped_type;
+        typedef ft::pair<const Key, T>				value_type;
+        typedef Compare								key_compare;
+        typedef Hash								hasher;
+        typedef Alloc								allocator_type;
+        typedef size_t								size_type;
+        typedef ft::map<Key, T, Compare, Alloc>		map_type;
+    private:
+        typedef typename map_type::const_iterator	const_iterator;
+
+//		Padded to its own cache lines, so that locking one shard does not bounce the line of its neighbour.
+        struct shard {
+            pthread_rwlock_t	lock;
+            map_type			map;
+            char				pad[64];
+
+            shard(const key_compare& comp, const allocator_type& alloc) : map(comp, alloc) {
+                pthread_rwlock_init(&lock, 0);
+            }
+
+            ~shard() {
+                pthread_rwlock_destroy(&lock);
+            }
+        private:
+            shard(const shard&);
+            shard& operator=(const shard&);
+        };
+
+        typedef typename Alloc::template rebind<shard>::other	shard_allocator;
+
+//		Holds a lock for the scope, so that an exception thrown by the map lets go of it.
+        class read_lock {
+            pthread_rwlock_t*	_lock;
+
+            read_lock(const read_lock&);
+            read_lock& operator=(const read_lock&);
+        public:
+            explicit read_lock(pthread_rwlock_t* lock) : _lock(lock) {
+                pthread_rwlock_rdlock(_lock);
+            }
+
+            ~read_lock() {
+                pthread_rwlock_unlock(_lock);
+            }
+        };
+
+        class write_lock {
+            pthread_rwlock_t*	_lock;
+
+            write_lock(const write_lock&);
+            write_lock& operator=(const write_lock&);
+        public:
+            explicit write_lock(pthread_rwlock_t* lock) : _lock(lock) {
+                pthread_rwlock_wrlock(_lock);
+            }
+
+            ~write_lock() {
+                pthread_rwlock_unlock(_lock);
+            }
+        };
+
+//		Read-locks shards [0, n) in order and unlocks all of them at the end of the scope.
+        class read_all {
+            shard*	_shards;
+            size_t	_locked;
+
+            read_all(const read_all&);
+            read_all& operator=(const read_all&);
+        public:
+            read_all(shard* shards, size_t n) : _shards(shards), _locked(0) {
+                for (; _locked < n; ++_locked)
+                    pthread_rwlock_rdlock(&_shards[_locked].lock);
+            }
+
+            ~read_all() {
+                while (_locked)
+                    pthread_rwlock_unlock(&_shards[--_locked].lock);
+            }
+        };
+
+        shard*			_shards;
+        size_t			_count;
+        hasher			_hash;
+        key_compare		_k_comp;
+        allocator_type	_alloc;
+
+        concurrent_map(const concurrent_map&);
+        concurrent_map& operator=(const concurrent_map&);
+
+//		The hash is mixed first: stride-16 integers or aligned pointers would all land in shard 0 otherwise.
+        shard& shard_of(const key_type& k) const {
+            return _shards[ft::hash_mix(_hash(k)) % _count];
+        }
+
+    public:
+//		More shards than threads keeps two writers from meeting on the same shard most of the time.
+        explicit concurrent_map(size_type shards = 16, const key_compare& comp = key_compare(), const hasher& hash = hasher(), const allocator_type& alloc = allocator_type()) : _shards(0), _count(shards), _hash(hash), _k_comp(comp), _alloc(alloc) {
+            if (!shards)
+                throw std::logic_error("Error: A concurrent map needs at least one shard!");
+            shard_allocator allocator(_alloc);
+            _shards = allocator.allocate(_count);
+            size_t built = 0;
+            try {
+                for (; built < _count; ++built)
+                    ::new(static_cast<void*>(_shards + built)) shard(_k_comp, _alloc);
+            } catch (...) {
+                while (built)
+                    _shards[--built].~shard();
+                allocator.deallocate(_shards, _count);
+                throw;
+            }
+        }
+
+//		No other thread may use the map any more.
+        ~concurrent_map() {
+            for (size_t i = 0; i < _count; ++i)
+                _shards[i].~shard();
+            shard_allocator(_alloc).deallocate(_shards, _count);
+        }
+
+        size_type shard_count() const {
+            return _count;
+        }
+
+//		Sum over all shards, read-locked together.
+        size_type size() const {
+            read_all locked(_shards, _count);
+            size_type n = 0;
+
+            for (size_t i = 0; i < _count; ++i)
+                n += _shards[i].map.size();
+            return n;
+        }
+
+        bool empty() const {
+            return size() == 0;
+        }
+
+//		Copies the mapped value of k into out when k is there.
+        bool find(const key_type& k, mapped_type& out) const {
+            shard& s = shard_of(k);
+            read_lock locked(&s.lock);
+            const_iterator it = s.map.find(k);
+
+            if (it == s.map.end())
+                return false;
+            out = it->second;
+            return true;
+        }
+
+        bool contains(const key_type& k) const {
+            shard& s = shard_of(k);
+            read_lock locked(&s.lock);
+
+            return s.map.count(k) != 0;
+        }
+
+//		False when the key was already there, which leaves its value as it was.
+        bool insert(const value_type& val) {
+            shard& s = shard_of(val.first);
+            write_lock locked(&s.lock);
+
+            return s.map.insert(val).second;
+        }
+
+//		Inserts or overwrites, true when the key was new.
+        bool insert_or_assign(const key_type& k, const mapped_type& obj) {
+            shard& s = shard_of(k);
+            write_lock locked(&s.lock);
+            ft::pair<typename map_type::iterator, bool> res = s.map.insert(value_type(k, obj));
+
+            if (!res.second)
+                res.first->second = obj;
+            return res.second;
+        }
+
+        size_type erase(const key_type& k) {
+            shard& s = shard_of(k);
+            write_lock locked(&s.lock);
+
+            return s.map.erase(k);
+        }
+
+        void clear() {
+            for (size_t i = 0; i < _count; ++i) {
+                write_lock locked(&_shards[i].lock);
+                _shards[i].map.clear();
+            }
+        }
+
+//		Calls f on every element with a key in [lo, hi), in key order, and returns f.
+//		The shards are merged by picking the smallest head each time, f must not call back into this map.
+        template <class Function>
+        Function for_each_in_range(const key_type& lo, const key_type& hi, Function f) const {
+            read_all locked(_shards, _count);
+            ft::vector<const_iterator> heads;
+            ft::vector<const_iterator> ends;
+
+            if (!_k_comp(lo, hi))
+                return f;
+            for (size_t i = 0; i < _count; ++i) {
+                const_iterator first = _shards[i].map.lower_bound(lo);
+                const_iterator last = _shards[i].map.lower_bound(hi);
+                if (first != last) {
+                    heads.push_back(first);
+                    ends.push_back(last);
+                }
+            }
+            while (!heads.empty()) {
+                size_t least = 0;
+                for (size_t i = 1; i < heads.size(); ++i) {
+                    if (_k_comp(heads[i]->first, heads[least]->first))
+                        least = i;
+                }
+                f(*heads[least]);
+                if (++heads[least] == ends[least]) {
+                    heads[least] = heads.back();
+                    ends[least] = ends.back();
+                    heads.pop_back();
+                    ends.pop_back();
+                }
+            }
+            return f;
+        }
+
+        key_compare key_comp() const {
+            return _k_comp;
+        }
+
+        hasher hash_function() const {
+            return _hash;
+        }
+
+        allocator_type get_allocator() const {
+            return _alloc;
+        }
+    };
+}
@@ -0,0 +1,317 @@
+#pragma once
+
+#include "iterator.hpp"
+#include "utils.hpp"
+#include "flat_tree.hpp"
+
+namespace ft {
+//	ft::set on a sorted ft::vector: no per-element node, lookups by binary search and iteration over contiguous memory.
+//	Meant for read-mostly sets: a single insert or erase shifts the keys after it, so fill it with the range insert, which sorts and merges once.
+//	Inserting or erasing invalidates iterators, and there are no node handles, set algebra or order statistics.
+    template <class Key, class Compare = ft::less<Key>, class Alloc = std::allocator<Key> >
+    class flat_set {
+    public:
+        typedef Key										key_type;
+        typedef key_type								value_type;
+        typedef size_t									size_type;
+        typedef Compare									key_compare;
+        typedef key_compare								value_compare;
+        typedef Alloc									allocator_type;
+        typedef value_type&								reference;
+        typedef const value_type&						const_reference;
+        typedef typename allocator_type::pointer		pointer;
+        typedef typename allocator_type::const_pointer	const_pointer;
+        typedef std::ptrdiff_t							difference_type;
+        typedef ft::vector_iterator<const value_type*>	iterator;
+        typedef ft::vector_iterator<const value_type*>	const_iterator;
+        typedef ft::reverse_iterator<iterator>			reverse_iterator;
+        typedef ft::reverse_iterator<const_iterator>	const_reverse_iterator;
+    private:
+        typedef ft::FlatTree<value_type, value_compare, Alloc>	tree_type;
+
+        tree_type		_tree;
+        allocator_type	_alloc;
+        key_compare		_k_comp;
+
+//		Return type R for lookups by a key of type K, only when Compare is transparent.
+        template <class K, class R>
+        struct enable_if_transparent : public ft::enable_if<ft::is_transparent<Compare>::value, R> {};
+
+        const_iterator iterator_at(size_type i) const {
+            return _tree.data().begin() + i;
+        }
+    public:
+        explicit flat_set(const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type()) : _tree(alloc, comp), _alloc(alloc), _k_comp(comp) {}
+
+        template <class InputIterator>
+        flat_set(InputIterator first, InputIterator last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type()) : _tree(alloc, comp), _alloc(alloc), _k_comp(comp) {
+            insert(first, last);
+        }
+
+//		[first, last) must be sorted without duplicates, it is then copied without sorting.
+        template <class InputIterator>
+        flat_set(ft::sorted_unique_t, InputIterator first, InputIterator last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type()) : _tree(alloc, comp), _alloc(alloc), _k_comp(comp) {
+            insert(ft::sorted_unique, first, last);
+        }
+
+        ~flat_set() {}
+
+        flat_set(const flat_set& other) : _tree(other._alloc, other._k_comp), _alloc(other._alloc), _k_comp(other._k_comp) {
+            *this = other;
+        }
+
+        flat_set& operator=(const flat_set& other) {
+            if (this != &other) {
+                _tree.assign(other._tree);
+                _alloc = other._alloc;
+                _k_comp = other._k_comp;
+            }
+            return *this;
+        }
+
+	//	************ iterators *************
+
+        iterator begin() {
+            return iterator_at(0);
+        }
+
+        const_iterator begin() const {
+            return _tree.data().begin();
+        }
+
+        iterator end() {
+            return iterator_at(size());
+        }
+
+        const_iterator end() const {
+            return _tree.data().end();
+        }
+
+        reverse_iterator rbegin() {
+            return reverse_iterator(end());
+        }
+
+        const_reverse_iterator rbegin() const {
+            return const_reverse_iterator(end());
+        }
+
+        reverse_iterator rend() {
+            return reverse_iterator(begin());
+        }
+
+        const_reverse_iterator rend() const {
+            return const_reverse_iterator(begin());
+        }
+
+        bool empty() const {
+            return _tree.size() == 0;
+        }
+
+        size_type size() const {
+            return _tree.size();
+        }
+
+        size_type max_size() const {
+            return _tree.max_size();
+        }
+
+        size_type capacity() const {
+            return _tree.capacity();
+        }
+
+//		Room for n keys, so that filling the set does not reallocate.
+        void reserve(size_type n) {
+            _tree.reserve(n);
+        }
+
+	//	************ funcs **********
+
+        ft::pair<iterator, bool> insert(const value_type& val) {
+            ft::pair<size_type, bool> res = _tree.insert(val);
+            return ft::pair<iterator, bool>(iterator_at(res.first), res.second);
+        }
+
+        iterator insert(iterator position, const value_type& val) {
+            return iterator_at(_tree.insert(position - begin(), val).first);
+        }
+
+//		Appends [first, last), sorts it and merges it with the keys already here in one pass.
+        template <class InputIterator>
+        void insert(InputIterator first, InputIterator last) {
+            _tree.insert_range(first, last, false);
+        }
+
+        template <class InputIterator>
+        void insert(ft::sorted_unique_t, InputIterator first, InputIterator last) {
+            _tree.insert_range(first, last, true);
+        }
+
+//		Returns the key that followed the erased one.
+        iterator erase(iterator position) {
+            size_t i = position - begin();
+
+            _tree.erase_at(i);
+            return begin() + i;
+        }
+
+        size_type erase(const key_type& k) {
+            return _tree.erase(k);
+        }
+
+        template <class K>
+        typename enable_if_transparent<K, size_type>::type erase(const K& k) {
+            return _tree.erase(k);
+        }
+
+        void erase(iterator first, iterator last) {
+            _tree.erase_range(first - begin(), last - begin());
+        }
+
+        void swap(flat_set& x) {
+            allocator_type alloc = _alloc;
+            key_compare key = _k_comp;
+            _tree.swap(x._tree);
+            _alloc = x._alloc;
+            _k_comp = x._k_comp;
+            x._alloc = alloc;
+            x._k_comp = key;
+        }
+
+        void clear() {
+            _tree.clear();
+        }
+
+        key_compare key_comp() const {
+            return _k_comp;
+        }
+
+        value_compare value_comp() const {
+            return _k_comp;
+        }
+
+        iterator find(const key_type& k) {
+            return iterator_at(_tree.find_index(k));
+        }
+
+        const_iterator find(const key_type& k) const {
+            return iterator_at(_tree.find_index(k));
+        }
+
+        size_type count(const key_type& k) const {
+            if (_tree.find_index(k) != size())
+                return 1;
+            return 0;
+        }
+
+        iterator lower_bound(const key_type& k) {
+            return iterator_at(_tree.lower_index(k));
+        }
+
+        const_iterator lower_bound(const key_type& k) const {
+            return iterator_at(_tree.lower_index(k));
+        }
+
+        iterator upper_bound(const key_type& k) {
+            return iterator_at(_tree.upper_index(k));
+        }
+
+        const_iterator upper_bound(const key_type& k) const {
+            return iterator_at(_tree.upper_index(k));
+        }
+
+        ft::pair <iterator, iterator> equal_range(const key_type& k) {
+            return ft::make_pair(lower_bound(k), upper_bound(k));
+        }
+
+        ft::pair <const_iterator, const_iterator> equal_range(const key_type& k) const {
+            return ft::make_pair(lower_bound(k), upper_bound(k));
+        }
+
+//		Heterogeneous lookup with a transparent Compare such as ft::less<void>.
+        template <class K>
+        typename enable_if_transparent<K, iterator>::type find(const K& k) {
+            return iterator_at(_tree.find_index(k));
+        }
+
+        template <class K>
+        typename enable_if_transparent<K, const_iterator>::type find(const K& k) const {
+            return iterator_at(_tree.find_index(k));
+        }
+
+        template <class K>
+        typename enable_if_transparent<K, size_type>::type count(const K& k) const {
+            if (_tree.find_index(k) != size())
+                return 1;
+            return 0;
+        }
+
+        template <class K>
+        typename enable_if_transparent<K, iterator>::type lower_bound(const K& k) {
+            return iterator_at(_tree.lower_index(k));
+        }
+
+        template <class K>
+        typename enable_if_transparent<K, const_iterator>::type lower_bound(const K& k) const {
+            return iterator_at(_tree.lower_index(k));
+        }
+
+        template <class K>
+        typename enable_if_transparent<K, iterator>::type upper_bound(const K& k) {
+            return iterator_at(_tree.upper_index(k));
+        }
+
+        template <class K>
+        typename enable_if_transparent<K, const_iterator>::type upper_bound(const K& k) const {
+            return iterator_at(_tree.upper_index(k));
+        }
+
+        template <class K>
+        typename enable_if_transparent<K, ft::pair<iterator, iterator> >::type equal_range(const K& k) {
+            return ft::make_pair(lower_bound(k), upper_bound(k));
+        }
+
+        template <class K>
+        typename enable_if_transparent<K, ft::pair<const_iterator, const_iterator> >::type equal_range(const K& k) const {
+            return ft::make_pair(lower_bound(k), upper_bound(k));
+        }
+
+        allocator_type get_allocator() const {
+            return _alloc;
+        }
+    };
+
+    template <class Key, class Compare, class Allocator>
+    bool operator==(const flat_set<Key, Compare, Allocator>& x, const flat_set<Key, Compare, Allocator>& y) {
+        return x.size() == y.size() && ft::equal(x.begin(), x.end(), y.begin());
+    }
+
+    template <class Key, class Compare, class Allocator>
+    bool operator!=(const flat_set<Key, Compare, Allocator>& x, const flat_set<Key, Compare, Allocator>& y) {
+        return !(x == y);
+    }
+
+    template <class Key, class Compare, class Allocator>
+    bool operator<(const flat_set<Key, Compare, Allocator>& x, const flat_set<Key, Compare, Allocator>& y) {
+        return ft::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
+    }
+
+    template <class Key, class Compare, class Allocator>
+    bool operator<=(const flat_set<Key, Compare, Allocator>& x, const flat_set<Key, Compare, Allocator>& y) {
+        return !(y < x);
+    }
+
+    template <class Key, class Compare, class Allocator>
+    bool operator>(const flat_set<Key, Compare, Allocator>& x, const flat_set<Key, Compare, Allocator>& y) {
+        return y < x;
+    }
+
+    template <class Key, class Compare, class Allocator>
+    bool operator>=(const flat_set<Key, Compare, Allocator>& x, const flat_set<Key, Compare, Allocator>& y) {
+        return !(x < y);
+    }
+
+    template <class Key, class Compare, class Allocator>
+    void swap(flat_set<Key, Compare, Allocator>& x, flat_set<Key, Compare, Allocator>& y) {
+        x.swap(y);
+    }
+}
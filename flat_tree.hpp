@@ -0,0 +1,178 @@
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include "utils.hpp"
+#include "pair.hpp"
+#include "vector.hpp"
+
+namespace ft {
+//	Sorted ft::vector of unique values, the engine of flat_map and flat_set.
+//	Positions are indices into the vector: lookups are binary searches over contiguous memory, inserting or erasing one value shifts the ones after it.
+//	Values must be copy assignable, since sorting and merging a range assign them.
+    template <class Value, class Compare, class Alloc = std::allocator<Value> >
+    class FlatTree {
+    public:
+        typedef ft::vector<Value, Alloc>	container_type;
+        typedef Alloc						allocator_type;
+    private:
+        container_type	_data;
+        Compare			_compare;
+
+        FlatTree(const FlatTree&);
+        FlatTree& operator=(const FlatTree&);
+
+    public:
+        explicit FlatTree(const allocator_type& alloc = allocator_type(), const Compare& compare = Compare()) : _data(alloc), _compare(compare) {}
+
+        container_type& data() {
+            return _data;
+        }
+
+        const container_type& data() const {
+            return _data;
+        }
+
+        size_t size() const {
+            return _data.size();
+        }
+
+        size_t max_size() const {
+            return _data.max_size();
+        }
+
+        size_t capacity() const {
+            return _data.capacity();
+        }
+
+        void reserve(size_t n) {
+            _data.reserve(n);
+        }
+
+        void clear() {
+            _data.clear();
+        }
+
+        void assign(const FlatTree& other) {
+            _data = other._data;
+            _compare = other._compare;
+        }
+
+        void swap(FlatTree& other) {
+            Compare compare = _compare;
+            _data.swap(other._data);
+            _compare = other._compare;
+            other._compare = compare;
+        }
+
+//		Index of the first value not less than key.
+        template <class K>
+        size_t lower_index(const K& key) const {
+            size_t low = 0;
+            size_t high = _data.size();
+
+            while (low < high) {
+                size_t mid = (low + high) / 2;
+                if (_compare(_data[mid], key))
+                    low = mid + 1;
+                else
+                    high = mid;
+            }
+            return low;
+        }
+
+        template <class K>
+        size_t upper_index(const K& key) const {
+            size_t low = 0;
+            size_t high = _data.size();
+
+            while (low < high) {
+                size_t mid = (low + high) / 2;
+                if (_compare(key, _data[mid]))
+                    high = mid;
+                else
+                    low = mid + 1;
+            }
+            return low;
+        }
+
+//		size() when key is not there.
+        template <class K>
+        size_t find_index(const K& key) const {
+            size_t i = lower_index(key);
+
+            if (i < _data.size() && !_compare(key, _data[i]))
+                return i;
+            return _data.size();
+        }
+
+        void insert_at(size_t i, const Value& val) {
+            _data.insert(_data.begin() + i, val);
+        }
+
+        ft::pair<size_t, bool> insert(const Value& val) {
+            size_t i = lower_index(val);
+
+            if (i < _data.size() && !_compare(val, _data[i]))
+                return ft::pair<size_t, bool>(i, false);
+            insert_at(i, val);
+            return ft::pair<size_t, bool>(i, true);
+        }
+
+//		Inserts at hint without a search when val belongs right before it, appending at size() is then amortized O(1).
+        ft::pair<size_t, bool> insert(size_t hint, const Value& val) {
+            if ((hint == 0 || _compare(_data[hint - 1], val)) && (hint == _data.size() || _compare(val, _data[hint]))) {
+                insert_at(hint, val);
+                return ft::pair<size_t, bool>(hint, true);
+            }
+            return insert(val);
+        }
+
+//		Appends the whole range, sorts it unless it is promised sorted, merges it with the values already here and drops the duplicates in one pass.
+//		Among equivalent values the one already here wins, then the first one of the range, as with inserting them one by one.
+        template <class InputIterator>
+        void insert_range(InputIterator first, InputIterator last, bool sorted) {
+            size_t old = _data.size();
+
+            _data.insert(_data.end(), first, last);
+            if (_data.size() == old)
+                return;
+            Value* base = &_data[0];
+            Value* middle = base + old;
+            Value* end = base + _data.size();
+            size_t from = old ? old - 1 : 0;
+
+            if (!sorted)
+                std::stable_sort(middle, end, _compare);
+            if (old && _compare(*middle, middle[-1])) {
+                std::inplace_merge(base, middle, end, _compare);
+                from = 0;
+            }
+            size_t kept = from;
+            for (size_t i = from + 1; i < _data.size(); ++i) {
+                if (_compare(base[kept], base[i]) && ++kept != i)
+                    base[kept] = base[i];
+            }
+            _data.erase(_data.begin() + (kept + 1), _data.end());
+        }
+
+//		Positional erases have their own names: an index passed to an overloaded erase() would be taken for a key.
+        void erase_at(size_t i) {
+            _data.erase(_data.begin() + i);
+        }
+
+        void erase_range(size_t first, size_t last) {
+            _data.erase(_data.begin() + first, _data.begin() + last);
+        }
+
+        template <class K>
+        size_t erase(const K& key) {
+            size_t i = find_index(key);
+
+            if (i == _data.size())
+                return 0;
+            erase_at(i);
+            return 1;
+        }
+    };
+}
@@ -0,0 +1,571 @@
+#pragma once
+
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#ifdef __SSE2__
+# include <emmintrin.h>
+#endif
+#include "utils.hpp"
+#include "pair.hpp"
+
+namespace ft {
+//	FNV-1a over n bytes.
+    inline size_t hash_bytes(const void* p, size_t n) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(p);
+        size_t h = 2166136261U;
+
+        for (size_t i = 0; i < n; ++i) {
+            h ^= bytes[i];
+            h *= 16777619U;
+        }
+        return h;
+    }
+
+//	Spreads every bit of a hash over the low and the high ones, for hashes as weak as the identity or an aligned pointer.
+//	Containers apply it to whatever their Hash returns before they use some of its bits.
+    inline size_t hash_mix(size_t h) {
+        h ^= h >> 16;
+        h *= 0x85EBCA6BU;
+        h ^= h >> 13;
+        h *= 0xC2B2AE35U;
+        h ^= h >> 16;
+        return h;
+    }
+
+//	Hash of unordered_map and unordered_set. Integers hash to themselves, the table mixes every hash before it uses it.
+    template <class T>
+    struct hash {
+        size_t operator()(const T& x) const {
+            return static_cast<size_t>(x);
+        }
+    };
+
+    template <class T>
+    struct hash<T*> {
+        size_t operator()(T* p) const {
+            return reinterpret_cast<size_t>(p);
+        }
+    };
+
+//	0.0 and -0.0 are equal, so both hash as 0.
+    template <>
+    struct hash<float> {
+        size_t operator()(float x) const {
+            return x == 0 ? 0 : ft::hash_bytes(&x, sizeof(x));
+        }
+    };
+
+    template <>
+    struct hash<double> {
+        size_t operator()(double x) const {
+            return x == 0 ? 0 : ft::hash_bytes(&x, sizeof(x));
+        }
+    };
+
+    template <>
+    struct hash<std::string> {
+        size_t operator()(const std::string& s) const {
+            return ft::hash_bytes(s.data(), s.size());
+        }
+    };
+
+//	Control byte of a slot: empty, deleted, or the low 7 bits of the hash of the value in it.
+//	The sentinel closes the control bytes, iterators stop on it.
+    struct hash_ctrl {
+        static const signed char	empty = -128;
+        static const signed char	deleted = -2;
+        static const signed char	sentinel = -1;
+    };
+
+//	Sixteen control bytes matched at once, with SSE2 when the target has it. A match is a mask with bit i set for byte i.
+    class hash_group {
+    public:
+        static const size_t	width = 16;
+    private:
+#ifdef __SSE2__
+        __m128i				_ctrl;
+#else
+        const signed char*	_ctrl;
+#endif
+    public:
+#ifdef __SSE2__
+        explicit hash_group(const signed char* ctrl) : _ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl))) {}
+
+        unsigned match(signed char h2) const {
+            return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), _ctrl)));
+        }
+
+        unsigned match_empty_or_deleted() const {
+            return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(hash_ctrl::sentinel), _ctrl)));
+        }
+#else
+        explicit hash_group(const signed char* ctrl) : _ctrl(ctrl) {}
+
+        unsigned match(signed char h2) const {
+            unsigned mask = 0;
+
+            for (size_t i = 0; i < width; ++i) {
+                if (_ctrl[i] == h2)
+                    mask |= 1U << i;
+            }
+            return mask;
+        }
+
+        unsigned match_empty_or_deleted() const {
+            unsigned mask = 0;
+
+            for (size_t i = 0; i < width; ++i) {
+                if (_ctrl[i] < hash_ctrl::sentinel)
+                    mask |= 1U << i;
+            }
+            return mask;
+        }
+#endif
+
+        unsigned match_empty() const {
+            return match(hash_ctrl::empty);
+        }
+
+        static size_t trailing_zeros(unsigned mask) {
+            return __builtin_ctz(mask);
+        }
+
+        static size_t leading_zeros(unsigned mask) {
+            return __builtin_clz(mask) - (sizeof(unsigned) * 8 - width);
+        }
+    };
+
+//	Walks the slots in table order, skipping the ones whose control byte is not full.
+//	Erasing leaves the other iterators valid, an insert that makes the table grow invalidates them all.
+    template <class T>
+    class hash_iterator {
+    public:
+        typedef std::ptrdiff_t									difference_type;
+        typedef T												value_type;
+        typedef T*												pointer;
+        typedef T&												reference;
+        typedef typename ft::switch_const<T>::type*				slot_ptr;
+        typedef std::forward_iterator_tag						iterator_category;
+    private:
+        const signed char*	_ctrl;
+        slot_ptr			_slot;
+    public:
+        hash_iterator() : _ctrl(0), _slot(0) {}
+
+        hash_iterator(const signed char* ctrl, slot_ptr slot) : _ctrl(ctrl), _slot(slot) {}
+
+        hash_iterator(const hash_iterator& other) : _ctrl(other._ctrl), _slot(other._slot) {}
+
+        ~hash_iterator() {}
+
+        hash_iterator& operator=(const hash_iterator& other) {
+            _ctrl = other._ctrl;
+            _slot = other._slot;
+            return *this;
+        }
+
+        template <class Type>
+        operator hash_iterator<const Type>() const {
+            return hash_iterator<const Type>(_ctrl, _slot);
+        }
+
+        reference operator*() const {
+            return *_slot;
+        }
+
+        pointer operator->() const {
+            return _slot;
+        }
+
+        const signed char* ctrl() const {
+            return _ctrl;
+        }
+
+        slot_ptr slot() const {
+            return _slot;
+        }
+
+        hash_iterator& operator++() {
+            do {
+                ++_ctrl;
+                ++_slot;
+            } while (*_ctrl < hash_ctrl::sentinel);
+            return *this;
+        }
+
+        hash_iterator operator++(int) {
+            hash_iterator tmp(*this);
+            ++(*this);
+            return tmp;
+        }
+    };
+
+    template <class Iterator1, class Iterator2>
+    bool operator==(const hash_iterator<Iterator1>& a, const hash_iterator<Iterator2>& b) {
+        return a.ctrl() == b.ctrl();
+    }
+
+    template <class Iterator1, class Iterator2>
+    bool operator!=(const hash_iterator<Iterator1>& a, const hash_iterator<Iterator2>& b) {
+        return !(a == b);
+    }
+
+//	Open addressing hash table of unique values, the engine of unordered_map and unordered_set.
+//	The control bytes live apart from the slots: a probe reads a group of 16 of them and compares the 7 bit hash tag of all 16 at once,
+//	so the slots themselves are only touched on a likely match. Groups are probed triangularly over a power of two minus one slots,
+//	and the first 15 control bytes are mirrored after the sentinel so that a group can start on any slot.
+//	An erased slot becomes empty again when no probe can have gone past it, i.e. its neighbourhood was never full, and a tombstone otherwise.
+    template <class Value, class Hasher, class Equal, class Alloc = std::allocator<Value> >
+    class HashTable {
+    public:
+        typedef ft::hash_iterator<Value>		iterator;
+        typedef ft::hash_iterator<const Value>	const_iterator;
+        typedef Alloc							allocator_type;
+    private:
+        typedef typename Alloc::template rebind<signed char>::other	ctrl_allocator;
+
+        static const size_t	width = hash_group::width;
+
+        allocator_type	_alloc;
+        Hasher			_hash;
+        Equal			_equal;
+        signed char*	_ctrl;
+        Value*			_slots;
+        size_t			_capacity;
+        size_t			_size;
+        size_t			_growth_left;
+        float			_max_load;
+
+        HashTable(const HashTable&);
+        HashTable& operator=(const HashTable&);
+
+        static size_t h1(size_t hash) {
+            return hash >> 7;
+        }
+
+        static signed char h2(size_t hash) {
+            return static_cast<signed char>(hash & 0x7F);
+        }
+
+//		Slots that may be full or deleted before the table grows, one at least stays empty so that every probe ends.
+//		A factor too small to allow a single value in capacity slots still allows one, or the table could never take it nor grow.
+        size_t max_growth(size_t capacity) const {
+            size_t n = static_cast<size_t>(static_cast<double>(capacity) * _max_load);
+
+            if (!n)
+                return 1;
+            return n < capacity ? n : capacity - 1;
+        }
+
+        void set_ctrl(size_t i, signed char tag) {
+            _ctrl[i] = tag;
+            _ctrl[((i - (width - 1)) & _capacity) + (width - 1)] = tag;
+        }
+
+//		First empty or deleted slot on the probe sequence of hash.
+        size_t free_slot(size_t hash) const {
+            size_t offset = h1(hash) & _capacity;
+
+            for (size_t step = width; ; step += width) {
+                unsigned mask = hash_group(_ctrl + offset).match_empty_or_deleted();
+                if (mask)
+                    return (offset + hash_group::trailing_zeros(mask)) & _capacity;
+                offset = (offset + step) & _capacity;
+            }
+        }
+
+        void release(signed char* ctrl, Value* slots, size_t capacity) {
+            if (!capacity)
+                return;
+            ctrl_allocator(_alloc).deallocate(ctrl, capacity + width);
+            _alloc.deallocate(slots, capacity);
+        }
+
+        void destroy_values() {
+            for (size_t i = 0; _size && i < _capacity; ++i) {
+                if (_ctrl[i] >= 0) {
+                    _alloc.destroy(_slots + i);
+                    --_size;
+                }
+            }
+        }
+
+//		Moves every value into a table of the given capacity, which also drops the tombstones.
+//		The old values are destroyed once all of them were copied, so a throwing copy leaves the table as it was.
+        void resize(size_t capacity) {
+            signed char* old_ctrl = _ctrl;
+            Value* old_slots = _slots;
+            size_t old_capacity = _capacity;
+            signed char* ctrl = ctrl_allocator(_alloc).allocate(capacity + width);
+            Value* slots;
+
+            try {
+                slots = _alloc.allocate(capacity);
+            } catch (...) {
+                ctrl_allocator(_alloc).deallocate(ctrl, capacity + width);
+                throw;
+            }
+            std::memset(ctrl, hash_ctrl::empty, capacity + width);
+            ctrl[capacity] = hash_ctrl::sentinel;
+            _ctrl = ctrl;
+            _slots = slots;
+            _capacity = capacity;
+            size_t size = _size;
+            size_t copied = 0;
+            try {
+                for (size_t i = 0; i < old_capacity; ++i) {
+                    if (old_ctrl[i] < 0)
+                        continue;
+                    size_t hash = ft::hash_mix(_hash(old_slots[i]));
+                    size_t j = free_slot(hash);
+                    _alloc.construct(_slots + j, ft::move_if_noexcept(old_slots[i]));
+                    set_ctrl(j, h2(hash));
+                    ++copied;
+                }
+            } catch (...) {
+                _size = copied;
+                destroy_values();
+                release(_ctrl, _slots, _capacity);
+                _ctrl = old_ctrl;
+                _slots = old_slots;
+                _capacity = old_capacity;
+                _size = size;
+                throw;
+            }
+            for (size_t i = 0; i < old_capacity; ++i) {
+                if (old_ctrl[i] >= 0)
+                    _alloc.destroy(old_slots + i);
+            }
+            release(old_ctrl, old_slots, old_capacity);
+            _growth_left = max_growth(_capacity) - _size;
+        }
+
+//		Called when the next insert would take the last free slot: tombstones are dropped in place when they are many, otherwise the table doubles.
+//		With a small max_load_factor one doubling may not make room for one more value, so it doubles until it does.
+        void make_room() {
+            if (_capacity && _size * 2 <= max_growth(_capacity))
+                resize(_capacity);
+            else {
+                size_t capacity = _capacity ? _capacity * 2 + 1 : width - 1;
+                while (max_growth(capacity) <= _size)
+                    capacity = capacity * 2 + 1;
+                resize(capacity);
+            }
+        }
+
+        iterator iterator_at(size_t i) const {
+            return iterator(_ctrl + i, _slots + i);
+        }
+
+//		Index of the value equal to key, _capacity when it is not there.
+        template <class K>
+        size_t find_index(const K& key) const {
+            if (!_size)
+                return _capacity;
+            size_t hash = ft::hash_mix(_hash(key));
+            signed char tag = h2(hash);
+            size_t offset = h1(hash) & _capacity;
+
+            for (size_t step = width; ; step += width) {
+                hash_group group(_ctrl + offset);
+                for (unsigned mask = group.match(tag); mask; mask &= mask - 1) {
+                    size_t i = (offset + hash_group::trailing_zeros(mask)) & _capacity;
+                    if (_equal(_slots[i], key))
+                        return i;
+                }
+                if (group.match_empty())
+                    return _capacity;
+                offset = (offset + step) & _capacity;
+            }
+        }
+
+    public:
+        explicit HashTable(const allocator_type& alloc = allocator_type(), const Hasher& hash = Hasher(), const Equal& equal = Equal()) : _alloc(alloc), _hash(hash), _equal(equal), _ctrl(0), _slots(0), _capacity(0), _size(0), _growth_left(0), _max_load(0.875f) {}
+
+        ~HashTable() {
+            destroy_values();
+            release(_ctrl, _slots, _capacity);
+        }
+
+        size_t size() const {
+            return _size;
+        }
+
+        size_t max_size() const {
+            return _alloc.max_size();
+        }
+
+        size_t bucket_count() const {
+            return _capacity;
+        }
+
+        float load_factor() const {
+            return _capacity ? static_cast<float>(_size) / _capacity : 0;
+        }
+
+        float max_load_factor() const {
+            return _max_load;
+        }
+
+//		An open addressing table cannot be fuller than its slots, so the factor is in (0, 1].
+        void max_load_factor(float ml) {
+            if (!(ml > 0) || ml > 1)
+                throw std::logic_error("Error: Incorrect max load factor!");
+            _max_load = ml;
+            if (_capacity)
+                rehash(_capacity);
+        }
+
+//		At least n slots and enough of them for the values already here, n = 0 with an empty table frees everything.
+        void rehash(size_t n) {
+            if (!n && !_size) {
+                release(_ctrl, _slots, _capacity);
+                _ctrl = 0;
+                _slots = 0;
+                _capacity = 0;
+                _growth_left = 0;
+                return;
+            }
+            size_t capacity = width - 1;
+            while (capacity < n || max_growth(capacity) < _size)
+                capacity = capacity * 2 + 1;
+            resize(capacity);
+        }
+
+//		Room for n values without growing.
+        void reserve(size_t n) {
+            if (n <= _size + _growth_left)
+                return;
+            size_t capacity = width - 1;
+            while (max_growth(capacity) < n)
+                capacity = capacity * 2 + 1;
+            resize(capacity);
+        }
+
+        iterator begin() const {
+            if (!_size)
+                return end();
+            size_t i = 0;
+            while (_ctrl[i] < hash_ctrl::sentinel)
+                ++i;
+            return iterator_at(i);
+        }
+
+        iterator end() const {
+            return iterator_at(_capacity);
+        }
+
+//		Keeps the slots, like the buckets of a std::unordered_map.
+        void clear() {
+            destroy_values();
+            if (_capacity) {
+                std::memset(_ctrl, hash_ctrl::empty, _capacity + width);
+                _ctrl[_capacity] = hash_ctrl::sentinel;
+                _growth_left = max_growth(_capacity);
+            }
+        }
+
+        void assign(const HashTable& other) {
+            clear();
+            _hash = other._hash;
+            _equal = other._equal;
+            _max_load = other._max_load;
+            reserve(other._size);
+            for (iterator it = other.begin(); it != other.end(); ++it)
+                insert(*it);
+        }
+
+        void swap(HashTable& other) {
+            allocator_type alloc = _alloc;
+            Hasher hash = _hash;
+            Equal equal = _equal;
+            signed char* ctrl = _ctrl;
+            Value* slots = _slots;
+            size_t capacity = _capacity;
+            size_t size = _size;
+            size_t growth_left = _growth_left;
+            float max_load = _max_load;
+            _alloc = other._alloc;
+            _hash = other._hash;
+            _equal = other._equal;
+            _ctrl = other._ctrl;
+            _slots = other._slots;
+            _capacity = other._capacity;
+            _size = other._size;
+            _growth_left = other._growth_left;
+            _max_load = other._max_load;
+            other._alloc = alloc;
+            other._hash = hash;
+            other._equal = equal;
+            other._ctrl = ctrl;
+            other._slots = slots;
+            other._capacity = capacity;
+            other._size = size;
+            other._growth_left = growth_left;
+            other._max_load = max_load;
+        }
+
+        Hasher hash_function() const {
+            return _hash;
+        }
+
+        Equal key_eq() const {
+            return _equal;
+        }
+
+        template <class K>
+        iterator find(const K& key) const {
+            return iterator_at(find_index(key));
+        }
+
+        ft::pair<iterator, bool> insert(const Value& val) {
+            size_t i = find_index(val);
+
+            if (i != _capacity)
+                return ft::pair<iterator, bool>(iterator_at(i), false);
+            size_t hash = ft::hash_mix(_hash(val));
+            i = _capacity ? free_slot(hash) : 0;
+            if (!_capacity || (!_growth_left && _ctrl[i] == hash_ctrl::empty)) {
+                make_room();
+                i = free_slot(hash);
+            }
+            _alloc.construct(_slots + i, val);
+            _growth_left -= _ctrl[i] == hash_ctrl::empty;
+            set_ctrl(i, h2(hash));
+            ++_size;
+            return ft::pair<iterator, bool>(iterator_at(i), true);
+        }
+
+        void erase(const_iterator where) {
+            size_t i = where.ctrl() - _ctrl;
+            unsigned empty_after = hash_group(_ctrl + i).match_empty();
+            unsigned empty_before = hash_group(_ctrl + ((i - width) & _capacity)).match_empty();
+            bool never_full = empty_before && empty_after && hash_group::trailing_zeros(empty_after) + hash_group::leading_zeros(empty_before) < width;
+
+            _alloc.destroy(_slots + i);
+            --_size;
+            if (never_full) {
+                set_ctrl(i, hash_ctrl::empty);
+                ++_growth_left;
+            }
+            else
+                set_ctrl(i, hash_ctrl::deleted);
+        }
+
+        void erase(iterator where) {
+            erase(const_iterator(where));
+        }
+
+        template <class K>
+        size_t erase(const K& key) {
+            size_t i = find_index(key);
+
+            if (i == _capacity)
+                return 0;
+            erase(iterator_at(i));
+            return 1;
+        }
+    };
+}
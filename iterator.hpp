@@ -42,6 +42,12 @@ namespace ft {
 
         map_iterator(const map_iterator& other) : _root(other._root), _base(other._base) {}
 
+        map_iterator& operator=(const map_iterator& other) {
+            _root = other._root;
+            _base = other._base;
+            return *this;
+        }
+
         ~map_iterator() {}
 
         template <class Type>
@@ -57,19 +63,23 @@ namespace ft {
             return &(_base->pair);
         }
 
+//		Node the iterator points to, 0 for end().
+        node_ptr node() const {
+            return _base;
+        }
+
 //		Iterator overloads
 
+//		The root has no parent, so climbing past the last node reaches 0, which is end().
         map_iterator& operator++() {
             if (!_base)
                 return *this;
             else if (_base->right)
                 _base = min_node(_base->right);
-            else if (_base == max_node(_root->parent))
-                _base = 0;
             else {
-                while(_base->parent->right == _base)
-                    _base = _base->parent;
-                _base = _base->parent;
+                while (_base->get_parent() && _base->get_parent()->right == _base)
+                    _base = _base->get_parent();
+                _base = _base->get_parent();
             }
             return *this;
         }
@@ -80,15 +90,16 @@ namespace ft {
             return tmp;
         }
 
+//		From end() the header's cached rightmost node is taken.
         map_iterator& operator--() {
             if (!_base)
-                _base = max_node(_root->parent);
+                _base = _root->right;
             else if (_base->left)
                 _base = max_node(_base->left);
             else {
-                while(_base->parent->left == _base)
-                    _base = _base->parent;
-                _base = _base->parent;
+                while (_base->get_parent() && _base->get_parent()->left == _base)
+                    _base = _base->get_parent();
+                _base = _base->get_parent();
             }
             return *this;
         }
@@ -99,6 +110,25 @@ namespace ft {
             return tmp;
         }
 
+#ifdef FT_ORDER_STATISTICS
+//		In-order index of the iterator from the subtree sizes, the size for end().
+        difference_type position() const {
+            if (!_base)
+                return subtree_count(_root->parent);
+            return node_position(_base);
+        }
+
+//		Jumps n places in O(log n) by selecting from the root, past either end gives end().
+        map_iterator& operator+=(difference_type n) {
+            _base = select_node(_root->parent, size_t(position() + n));
+            return *this;
+        }
+
+        map_iterator& operator-=(difference_type n) {
+            return *this += -n;
+        }
+#endif
+
         template <class Iterator1, class Iterator2>
 		friend bool operator==(const map_iterator<Iterator1>& a, const map_iterator<Iterator2>& b) {
 			return a._base == b._base;
@@ -110,6 +140,18 @@ namespace ft {
         return !(a == b);
     }
 
+#ifdef FT_ORDER_STATISTICS
+    template <class T, class Distance>
+    void advance(map_iterator<T>& it, Distance n) {
+        it += n;
+    }
+
+    template <class T>
+    typename map_iterator<T>::difference_type distance(map_iterator<T> first, map_iterator<T> last) {
+        return last.position() - first.position();
+    }
+#endif
+
     template <class T>
     class reverse_iterator {
     private:
@@ -128,6 +170,11 @@ namespace ft {
 
         reverse_iterator(const reverse_iterator &it) : _val(it._val) {}
 
+        reverse_iterator& operator=(const reverse_iterator &other) {
+            _val = other._val;
+            return *this;
+        }
+
         ~reverse_iterator() {}
 
         template <class Type>
@@ -262,6 +309,11 @@ namespace ft {
 
         vector_iterator(const vector_iterator &it) : _val(it._val) {}
 
+        vector_iterator& operator=(const vector_iterator &other) {
+            _val = other._val;
+            return *this;
+        }
+
         ~vector_iterator() {}
 
         template <class Type>
@@ -1,5 +1,6 @@
 #include <iostream>
 #include <iterator>
+#include <algorithm>
 #include <vector>
 #include <stack>
 #include <map>
@@ -8,6 +9,46 @@
 #include "stack.hpp"
 #include "map.hpp"
 #include "set.hpp"
+#include "small_vector.hpp"
+#include "btree_map.hpp"
+#include "btree_set.hpp"
+#include "flat_map.hpp"
+#include "flat_set.hpp"
+#include "unordered_map.hpp"
+#include "unordered_set.hpp"
+#include "concurrent_map.hpp"
+#include "persistent_map.hpp"
+
+//	Compares an element of an ft map with the element of the std map at the same place.
+struct same_pair {
+	template <class FtPair, class StdPair>
+	bool operator()(const FtPair& a, const StdPair& b) const {
+		return a.first == b.first && a.second == b.second;
+	}
+};
+
+//	Work of one thread filling a concurrent_map: the keys 16 * i for i = first, first + 2, ... below 400.
+struct concurrent_fill {
+	ft::concurrent_map<int, int>*	map;
+	int								first;
+};
+
+void* fill_concurrent(void* arg) {
+	concurrent_fill* fill = static_cast<concurrent_fill*>(arg);
+
+	for (int i = fill->first; i < 400; i += 2)
+		fill->map->insert(ft::make_pair(i * 16, i));
+	return 0;
+}
+
+//	Collects the keys for_each_in_range() visits.
+struct collect_keys {
+	ft::vector<int>	keys;
+
+	void operator()(const ft::pair<const int, int>& p) {
+		keys.push_back(p.first);
+	}
+};
 
 int main() {
 //	STACK
@@ -260,7 +301,7 @@ int main() {
 	std::vector<int>::reverse_iterator stdReverseIterator = stdVector.rbegin();
 	ft::vector<int>::const_reverse_iterator myConstReverseIterator(myVector.rbegin());
 
-	for (int i = 0; i < 5; ++i) {
+	for (int i = 0; i < 3; ++i) {
 		myReverseIterator[i] = (5 - i) * 5;
 		stdReverseIterator[i] = (5 - i) * 5;
 	}
@@ -569,5 +610,585 @@ int main() {
 		std::cout << *itStdSet  << "      " <<  *itFtSet << "     " << std::endl;
 	}
 	std::cout << "-------------------------" << std::endl;
+	std::cout << std::endl;
+
+//  MAP / SET: TREE API
+	std::cout << "=========================" << std::endl;
+	std::cout << "   STD   MAP / SET   FT  " << std::endl;
+	std::cout << "____________|____________" << std::endl;
+
+	const char* fruits[] = {"pear", "apple", "fig", "kiwi", "plum", "lime"};
+	std::map<std::string, int> stdFruitMap;
+	ft::map<std::string, int, ft::less<void> > myFruitMap;
+
+	for (int i = 0; i < 6; i++) {
+		stdFruitMap[fruits[i]] = i;
+		myFruitMap[fruits[i]] = i;
+	}
+	std::cout << "heterogeneous lookup with ft::less<void>, keys by const char*: " << std::endl;
+	std::cout << "find(kiwi): \t" << stdFruitMap.find("kiwi")->second << "\t|\t" << myFruitMap.find("kiwi")->second << "\n";
+	std::cout << "count(fig): \t" << stdFruitMap.count("fig") << "\t|\t" << myFruitMap.count("fig") << "\n";
+	std::cout << "count(grape): \t" << stdFruitMap.count("grape") << "\t|\t" << myFruitMap.count("grape") << "\n";
+	std::cout << "lower_bound(grape): " << stdFruitMap.lower_bound("grape")->first << "\t|\t" << myFruitMap.lower_bound("grape")->first << "\n";
+	std::cout << "upper_bound(lime): " << stdFruitMap.upper_bound("lime")->first << "\t|\t" << myFruitMap.upper_bound("lime")->first << "\n";
+	std::cout << "erase(pear): \t" << stdFruitMap.erase("pear") << "\t|\t" << myFruitMap.erase("pear") << "\n";
+	std::cout << "erase(pear): \t" << stdFruitMap.erase("pear") << "\t|\t" << myFruitMap.erase("pear") << "\n";
+	std::cout << "same elements: " << ft::equal(myFruitMap.begin(), myFruitMap.end(), stdFruitMap.begin(), same_pair()) << std::endl;
+	std::set<std::string> stdFruitSet(fruits, fruits + 6);
+	ft::set<std::string, ft::less<void> > myFruitSet(fruits, fruits + 6);
+	std::cout << "set find(plum): " << *stdFruitSet.find("plum") << "\t|\t" << *myFruitSet.find("plum") << "\n";
+	std::cout << "set erase(apple): " << stdFruitSet.erase("apple") << "\t|\t" << myFruitSet.erase("apple") << "\n";
+	std::cout << "set lower_bound(b): " << *stdFruitSet.lower_bound("b") << "\t|\t" << *myFruitSet.lower_bound("b") << "\n";
+	std::cout << "-------------------------" << std::endl;
+
+	std::cout << "sorted_unique constructor: keys 0, 2, 4 ... 1998" << std::endl;
+	ft::vector<ft::pair<int, int> > sortedRun;
+	std::map<int, int> stdSortedMap;
+	for (int i = 0; i < 1000; i++) {
+		sortedRun.push_back(ft::make_pair(i * 2, i));
+		stdSortedMap.insert(std::make_pair(i * 2, i));
+	}
+	ft::map<int, int> mySortedMap(ft::sorted_unique, sortedRun.begin(), sortedRun.end());
+	std::cout << "Size: \t" << stdSortedMap.size() << "\t|\t" << mySortedMap.size() << "\n";
+	std::cout << "same elements: " << ft::equal(mySortedMap.begin(), mySortedMap.end(), stdSortedMap.begin(), same_pair()) << std::endl;
+	std::cout << "find(1000): \t" << stdSortedMap.find(1000)->second << "\t|\t" << mySortedMap.find(1000)->second << "\n";
+	std::cout << "rbegin(): \t" << stdSortedMap.rbegin()->first << "\t|\t" << mySortedMap.rbegin()->first << "\n";
+	for (int i = 0; i < 1000; i++) {
+		stdSortedMap.insert(std::make_pair(i * 2 + 1, -i));
+		mySortedMap.insert(ft::make_pair(i * 2 + 1, -i));
+	}
+	stdSortedMap.erase(stdSortedMap.lower_bound(500), stdSortedMap.lower_bound(1500));
+	mySortedMap.erase(mySortedMap.lower_bound(500), mySortedMap.lower_bound(1500));
+	std::cout << "insert the odd keys, erase range [500, 1500)" << std::endl;
+	std::cout << "Size: \t" << stdSortedMap.size() << "\t|\t" << mySortedMap.size() << "\n";
+	std::cout << "same elements: " << ft::equal(mySortedMap.begin(), mySortedMap.end(), stdSortedMap.begin(), same_pair()) << std::endl;
+	std::set<std::string> stdSortedSet(fruits, fruits + 6);
+	ft::vector<std::string> sortedFruits(stdSortedSet.begin(), stdSortedSet.end());
+	ft::set<std::string> mySortedSet(ft::sorted_unique, sortedFruits.begin(), sortedFruits.end());
+	std::cout << "set from the sorted fruits" << std::endl;
+	std::cout << "Size: \t" << stdSortedSet.size() << "\t|\t" << mySortedSet.size() << "\n";
+	std::cout << "same elements: " << ft::equal(mySortedSet.begin(), mySortedSet.end(), stdSortedSet.begin()) << std::endl;
+	std::cout << "insert(grape): \t" << stdSortedSet.insert("grape").second << "\t|\t" << mySortedSet.insert("grape").second << "\n";
+	std::cout << "insert(fig): \t" << stdSortedSet.insert("fig").second << "\t|\t" << mySortedSet.insert("fig").second << "\n";
+	std::cout << "same elements: " << ft::equal(mySortedSet.begin(), mySortedSet.end(), stdSortedSet.begin()) << std::endl;
+	std::cout << "-------------------------" << std::endl;
+
+#ifdef FT_ORDER_STATISTICS
+	std::cout << "order statistics, std::distance on std::map: " << std::endl;
+	std::cout << "nth(0): \t" << stdSortedMap.begin()->first << "\t|\t" << mySortedMap.nth(0)->first << "\n";
+	std::map<int, int>::iterator stdNth = stdSortedMap.begin();
+	std::advance(stdNth, 700);
+	std::cout << "nth(700): \t" << stdNth->first << "\t|\t" << mySortedMap.nth(700)->first << "\n";
+	std::cout << "nth(size()) == end(): " << (mySortedMap.nth(mySortedMap.size()) == mySortedMap.end()) << std::endl;
+	std::cout << "rank(250): \t" << std::distance(stdSortedMap.begin(), stdSortedMap.lower_bound(250)) << "\t|\t" << mySortedMap.rank(250) << "\n";
+	std::cout << "rank(1000): \t" << std::distance(stdSortedMap.begin(), stdSortedMap.lower_bound(1000)) << "\t|\t" << mySortedMap.rank(1000) << "\n";
+	std::cout << "rank(5000): \t" << std::distance(stdSortedMap.begin(), stdSortedMap.lower_bound(5000)) << "\t|\t" << mySortedMap.rank(5000) << "\n";
+	std::cout << "range_count(100, 1600): " << std::distance(stdSortedMap.lower_bound(100), stdSortedMap.lower_bound(1600)) << "\t|\t" << mySortedMap.range_count(100, 1600) << "\n";
+	std::cout << "range_count(1600, 100): 0\t|\t" << mySortedMap.range_count(1600, 100) << "\n";
+	bool sameRanks = true;
+	stdNth = stdSortedMap.begin();
+	for (size_t n = 0; n < stdSortedMap.size(); n++, stdNth++)
+		sameRanks = sameRanks && mySortedMap.nth(n)->first == stdNth->first && mySortedMap.rank(stdNth->first) == n;
+	std::cout << "nth / rank agree on every key: " << sameRanks << std::endl;
+	std::cout << "set nth(1): \t" << *++stdSortedSet.begin() << "\t|\t" << *mySortedSet.nth(1) << "\n";
+	std::cout << "set rank(kiwi): " << std::distance(stdSortedSet.begin(), stdSortedSet.find("kiwi")) << "\t|\t" << mySortedSet.rank("kiwi") << "\n";
+	std::cout << "-------------------------" << std::endl;
+#endif
+
+	std::cout << "split_at / join: " << std::endl;
+	std::set<int> stdLowSet;
+	std::set<int> stdHighSet;
+	ft::set<int> myLowSet;
+	ft::set<int> myHighSet;
+	for (int i = 0; i < 300; i++) {
+		stdLowSet.insert((i * 7) % 300);
+		myLowSet.insert((i * 7) % 300);
+	}
+	myHighSet.insert(-1);
+	stdHighSet.insert(stdLowSet.lower_bound(120), stdLowSet.end());
+	stdLowSet.erase(stdLowSet.lower_bound(120), stdLowSet.end());
+	myLowSet.split_at(120, myHighSet);
+	std::cout << "split_at(120) Size: " << stdLowSet.size() << " " << stdHighSet.size() << "\t|\t" << myLowSet.size() << " " << myHighSet.size() << "\n";
+	std::cout << "same elements: " << (ft::equal(myLowSet.begin(), myLowSet.end(), stdLowSet.begin()) && ft::equal(myHighSet.begin(), myHighSet.end(), stdHighSet.begin())) << std::endl;
+	std::cout << "begin() above: \t" << *stdHighSet.begin() << "\t|\t" << *myHighSet.begin() << "\n";
+	std::cout << "rbegin() below: " << *stdLowSet.rbegin() << "\t|\t" << *myLowSet.rbegin() << "\n";
+	stdLowSet.insert(stdHighSet.begin(), stdHighSet.end());
+	stdHighSet.clear();
+	myLowSet.join(myHighSet);
+	std::cout << "join back Size: " << stdLowSet.size() << " " << stdHighSet.size() << "\t|\t" << myLowSet.size() << " " << myHighSet.size() << "\n";
+	std::cout << "same elements: " << ft::equal(myLowSet.begin(), myLowSet.end(), stdLowSet.begin()) << std::endl;
+	for (int i = 0; i < 60; i++) {
+		stdHighSet.insert(i * 10);
+		myHighSet.insert(i * 10);
+	}
+	stdLowSet.insert(stdHighSet.begin(), stdHighSet.end());
+	stdHighSet.clear();
+	myLowSet.join(myHighSet);
+	std::cout << "join overlapping 0, 10 ... 590 Size: " << stdLowSet.size() << "\t|\t" << myLowSet.size() << "\n";
+	std::cout << "same elements: " << ft::equal(myLowSet.begin(), myLowSet.end(), stdLowSet.begin()) << std::endl;
+	std::cout << "-------------------------" << std::endl;
+
+	std::cout << "set_union / set_intersection / set_difference: " << std::endl;
+	std::map<int, int> stdLeftMap;
+	std::map<int, int> stdRightMap;
+	ft::map<int, int> myLeftMap;
+	ft::map<int, int> myRightMap;
+	for (int i = 0; i < 200; i++) {
+		stdLeftMap[i * 3] = i;
+		myLeftMap[i * 3] = i;
+		stdRightMap[i * 5] = -i;
+		myRightMap[i * 5] = -i;
+	}
+	std::map<int, int> stdSetResult;
+	ft::map<int, int> mySetResult(myLeftMap);
+	std::set_union(stdLeftMap.begin(), stdLeftMap.end(), stdRightMap.begin(), stdRightMap.end(), std::inserter(stdSetResult, stdSetResult.end()), stdLeftMap.value_comp());
+	mySetResult.set_union(myRightMap);
+	std::cout << "set_union Size: " << stdSetResult.size() << "\t|\t" << mySetResult.size() << "\n";
+	std::cout << "same elements: " << ft::equal(mySetResult.begin(), mySetResult.end(), stdSetResult.begin(), same_pair()) << std::endl;
+	stdSetResult.clear();
+	mySetResult = myLeftMap;
+	std::set_intersection(stdLeftMap.begin(), stdLeftMap.end(), stdRightMap.begin(), stdRightMap.end(), std::inserter(stdSetResult, stdSetResult.end()), stdLeftMap.value_comp());
+	mySetResult.set_intersection(myRightMap);
+	std::cout << "set_intersection Size: " << stdSetResult.size() << "\t|\t" << mySetResult.size() << "\n";
+	std::cout << "same elements: " << ft::equal(mySetResult.begin(), mySetResult.end(), stdSetResult.begin(), same_pair()) << std::endl;
+	stdSetResult.clear();
+	mySetResult = myLeftMap;
+	std::set_difference(stdLeftMap.begin(), stdLeftMap.end(), stdRightMap.begin(), stdRightMap.end(), std::inserter(stdSetResult, stdSetResult.end()), stdLeftMap.value_comp());
+	mySetResult.set_difference(myRightMap);
+	std::cout << "set_difference Size: " << stdSetResult.size() << "\t|\t" << mySetResult.size() << "\n";
+	std::cout << "same elements: " << ft::equal(mySetResult.begin(), mySetResult.end(), stdSetResult.begin(), same_pair()) << std::endl;
+	std::cout << "other untouched: " << ft::equal(myRightMap.begin(), myRightMap.end(), stdRightMap.begin(), same_pair()) << std::endl;
+	std::cout << "-------------------------" << std::endl;
+
+	std::cout << "extract / insert(node_type) / merge: " << std::endl;
+	std::map<int, std::string> stdNodeMap;
+	std::map<int, std::string> stdOtherNodeMap;
+	ft::map<int, std::string> myNodeMap;
+	ft::map<int, std::string> myOtherNodeMap;
+	for (int i = 0; i < 20; i++) {
+		stdNodeMap[i] = fruits[i % 6];
+		myNodeMap[i] = fruits[i % 6];
+		stdOtherNodeMap[i + 15] = "x";
+		myOtherNodeMap[i + 15] = "x";
+	}
+	std::cout << "insert(extract(5)): " << stdOtherNodeMap.insert(*stdNodeMap.find(5)).second << "\t|\t" << myOtherNodeMap.insert(myNodeMap.extract(5)).inserted << "\n";
+	stdNodeMap.erase(5);
+	std::cout << "moved value: \t" << stdOtherNodeMap[5] << "\t|\t" << myOtherNodeMap[5] << "\n";
+	ft::map<int, std::string>::insert_return_type taken = myOtherNodeMap.insert(myNodeMap.extract(16));
+	std::cout << "insert(extract(16)) inserted: " << stdOtherNodeMap.insert(*stdNodeMap.find(16)).second << "\t|\t" << taken.inserted << "\n";
+	stdNodeMap.erase(16);
+	std::cout << "node handed back: " << stdNodeMap.count(16) << " " << stdOtherNodeMap[16] << "\t|\t" << taken.node.empty() << " " << taken.node.mapped() << "\n";
+	taken.node = ft::map<int, std::string>::node_type();
+	std::cout << "extract(100) empty: " << myNodeMap.extract(100).empty() << std::endl;
+	std::cout << "Size: \t" << stdNodeMap.size() << " " << stdOtherNodeMap.size() << "\t|\t" << myNodeMap.size() << " " << myOtherNodeMap.size() << "\n";
+	for (std::map<int, std::string>::iterator it = stdOtherNodeMap.begin(); it != stdOtherNodeMap.end(); ) {
+		if (stdNodeMap.insert(*it).second)
+			stdOtherNodeMap.erase(it++);
+		else
+			++it;
+	}
+	myNodeMap.merge(myOtherNodeMap);
+	std::cout << "merge Size: \t" << stdNodeMap.size() << " " << stdOtherNodeMap.size() << "\t|\t" << myNodeMap.size() << " " << myOtherNodeMap.size() << "\n";
+	std::cout << "same elements: " << (ft::equal(myNodeMap.begin(), myNodeMap.end(), stdNodeMap.begin(), same_pair()) && ft::equal(myOtherNodeMap.begin(), myOtherNodeMap.end(), stdOtherNodeMap.begin(), same_pair())) << std::endl;
+	for (int i = 0; i < 10000; i++) {
+		stdNodeMap[100] = fruits[i % 6];
+		myNodeMap[100] = fruits[i % 6];
+		myNodeMap.insert(myNodeMap.extract(100));
+		myOtherNodeMap.insert(myNodeMap.extract(i % 15));
+		myNodeMap.insert(myOtherNodeMap.extract(i % 15));
+		if (i % 2) {
+			stdNodeMap.erase(100);
+			myNodeMap.extract(100);
+		}
+	}
+	std::cout << "10000 extract / insert round trips" << std::endl;
+	std::cout << "Size: \t" << stdNodeMap.size() << "\t|\t" << myNodeMap.size() << "\n";
+	std::cout << "same elements: " << ft::equal(myNodeMap.begin(), myNodeMap.end(), stdNodeMap.begin(), same_pair()) << std::endl;
+	for (int i = 0; i < 40; i += 3) {
+		stdNodeMap.erase(i);
+		myNodeMap.erase(i);
+	}
+	stdNodeMap[7] = "fig";
+	myNodeMap[7] = "fig";
+	std::cout << "erase every third key, [7] = fig" << std::endl;
+	std::cout << "Size: \t" << stdNodeMap.size() << "\t|\t" << myNodeMap.size() << "\n";
+	std::cout << "same elements: " << ft::equal(myNodeMap.begin(), myNodeMap.end(), stdNodeMap.begin(), same_pair()) << std::endl;
+	std::cout << "-------------------------" << std::endl;
+
+//  SMALL VECTOR
+	std::cout << "=========================" << std::endl;
+	std::cout << " STD VECTOR  SMALL_VECTOR" << std::endl;
+	std::cout << "____________|____________" << std::endl;
+
+	std::vector<int> stdSmall;
+	ft::small_vector<int, 4> mySmall;
+
+	for (int i = 1; i < 4; i++) {
+		stdSmall.push_back(i);
+		mySmall.push_back(i);
+	}
+	std::cout << "push_back: 1, 2, 3" << std::endl;
+	std::cout << "Size: \t" << stdSmall.size() << "\t|\t" << mySmall.size() << "\n";
+	std::cout << "inline: " << mySmall.is_inline() << std::endl;
+	stdSmall.push_back(4);
+	stdSmall.push_back(5);
+	mySmall.push_back(4);
+	mySmall.push_back(5);
+	std::cout << "push_back: 4, 5" << std::endl;
+	std::cout << "Size: \t" << stdSmall.size() << "\t|\t" << mySmall.size() << "\n";
+	std::cout << "inline: " << mySmall.is_inline() << std::endl;
+	std::cout << "mySmall: ";
+	for (ft::small_vector<int, 4>::iterator i = mySmall.begin(); i != mySmall.end(); i++)
+		std::cout << *i << " ";
+	std::cout << std::endl;
+
+	ft::stack<int, ft::small_vector<int, 4> > smallStack;
+
+	smallStack.push(21);
+	smallStack.push(42);
+	std::cout << "stack on small_vector top: " << smallStack.top() << std::endl;
+	std::cout << "-------------------------" << std::endl;
+
+//  BTREE MAP / BTREE SET
+	std::cout << "=========================" << std::endl;
+	std::cout << "   STD     MAP    BTREE  " << std::endl;
+	std::cout << "____________|____________" << std::endl;
+
+	std::map<int, int> stdTreeMap;
+	ft::btree_map<int, int> myTreeMap;
+
+	for (int i = 0; i < 200; i++) {
+		stdTreeMap[(i * 37) % 200] = i;
+		myTreeMap[(i * 37) % 200] = i;
+	}
+	std::cout << "operator[]: 200 keys in scattered order" << std::endl;
+	std::cout << "Size: \t" << stdTreeMap.size() << "\t|\t" << myTreeMap.size() << "\n";
+	std::cout << "[42]: \t" << stdTreeMap[42] << "\t|\t" << myTreeMap[42] << "\n";
+	std::cout << "Size: \t" << stdTreeMap.size() << "\t|\t" << myTreeMap.size() << "\n";
+	std::cout << "-------------------------" << std::endl;
+
+	std::cout << "find / lower_bound / upper_bound: " << std::endl;
+	std::cout << "find(77): \t" << stdTreeMap.find(77)->second << "\t|\t" << myTreeMap.find(77)->second << "\n";
+	std::cout << "count(500): \t" << stdTreeMap.count(500) << "\t|\t" << myTreeMap.count(500) << "\n";
+	stdTreeMap.erase(100);
+	myTreeMap.erase(100);
+	std::cout << "erase(100)" << std::endl;
+	std::cout << "lower_bound(100): " << stdTreeMap.lower_bound(100)->first << "\t|\t" << myTreeMap.lower_bound(100)->first << "\n";
+	std::cout << "upper_bound(100): " << stdTreeMap.upper_bound(100)->first << "\t|\t" << myTreeMap.upper_bound(100)->first << "\n";
+	std::cout << "-------------------------" << std::endl;
+
+	std::cout << "erase(it) returns the next element: " << std::endl;
+	std::map<int, int>::iterator stdTreeIt = stdTreeMap.find(36);
+	stdTreeMap.erase(stdTreeIt++);
+	ft::btree_map<int, int>::iterator myTreeIt = myTreeMap.erase(myTreeMap.find(36));
+	std::cout << "erase(find(36)): " << stdTreeIt->first << "\t|\t" << myTreeIt->first << "\n";
+	std::cout << "erase every even key" << std::endl;
+	for (stdTreeIt = stdTreeMap.begin(); stdTreeIt != stdTreeMap.end(); ) {
+		if (stdTreeIt->first % 2 == 0)
+			stdTreeMap.erase(stdTreeIt++);
+		else
+			++stdTreeIt;
+	}
+	for (myTreeIt = myTreeMap.begin(); myTreeIt != myTreeMap.end(); ) {
+		if (myTreeIt->first % 2 == 0)
+			myTreeIt = myTreeMap.erase(myTreeIt);
+		else
+			++myTreeIt;
+	}
+	std::cout << "Size: \t" << stdTreeMap.size() << "\t|\t" << myTreeMap.size() << "\n";
+	std::cout << "key   value  key   value" << std::endl;
+	stdTreeIt = stdTreeMap.begin();
+	myTreeIt = myTreeMap.begin();
+	for (int n = 0; n < 5; n++, stdTreeIt++, myTreeIt++) {
+		std::cout << stdTreeIt->first << "     " << stdTreeIt->second << "      " <<  myTreeIt->first << "     " << myTreeIt->second << std::endl;
+	}
+	std::cout << "same elements: " << ft::equal(myTreeMap.begin(), myTreeMap.end(), stdTreeMap.begin(), same_pair()) << std::endl;
+	std::cout << "-------------------------" << std::endl;
+
+	std::cout << "erase range [40, 160): " << std::endl;
+	stdTreeMap.erase(stdTreeMap.lower_bound(40), stdTreeMap.lower_bound(160));
+	myTreeMap.erase(myTreeMap.lower_bound(40), myTreeMap.lower_bound(160));
+	std::cout << "Size: \t" << stdTreeMap.size() << "\t|\t" << myTreeMap.size() << "\n";
+	std::cout << "same elements: " << ft::equal(myTreeMap.begin(), myTreeMap.end(), stdTreeMap.begin(), same_pair()) << std::endl;
+	std::cout << "rbegin(): \t" << stdTreeMap.rbegin()->first << "\t|\t" << myTreeMap.rbegin()->first << "\n";
+	std::cout << "-------------------------" << std::endl;
+
+	std::cout << "sorted_unique append: " << std::endl;
+	ft::vector<ft::pair<int, int> > sortedPairs;
+	for (int i = 200; i < 300; i++)
+		sortedPairs.push_back(ft::make_pair(i, -i));
+	myTreeMap.insert(ft::sorted_unique, sortedPairs.begin(), sortedPairs.end());
+	for (int i = 200; i < 300; i++)
+		stdTreeMap.insert(std::make_pair(i, -i));
+	std::cout << "Size: \t" << stdTreeMap.size() << "\t|\t" << myTreeMap.size() << "\n";
+	std::cout << "same elements: " << ft::equal(myTreeMap.begin(), myTreeMap.end(), stdTreeMap.begin(), same_pair()) << std::endl;
+	ft::btree_map<int, int> copyTreeMap(myTreeMap);
+	std::cout << "copy == original: " << (copyTreeMap == myTreeMap) << std::endl;
+	std::cout << "-------------------------" << std::endl;
+
+	std::set<std::string> stdTreeSet;
+	ft::btree_set<std::string> myTreeSet;
+	const char* words[] = {"pear", "apple", "fig", "kiwi", "plum", "apple", "lime"};
+
+	for (int i = 0; i < 7; i++) {
+		stdTreeSet.insert(words[i]);
+		myTreeSet.insert(words[i]);
+	}
+	std::cout << "btree_set insert: pear apple fig kiwi plum apple lime" << std::endl;
+	std::cout << "Size: \t" << stdTreeSet.size() << "\t|\t" << myTreeSet.size() << "\n";
+	std::set<std::string>::iterator stdWord = stdTreeSet.find("fig");
+	stdTreeSet.erase(stdWord++);
+	ft::btree_set<std::string>::iterator myWord = myTreeSet.erase(myTreeSet.find("fig"));
+	std::cout << "erase(find(fig)): " << *stdWord << "\t|\t" << *myWord << "\n";
+	std::cout << "std   ft" << std::endl;
+	stdWord = stdTreeSet.begin();
+	for (myWord = myTreeSet.begin(); myWord != myTreeSet.end(); myWord++, stdWord++)
+		std::cout << *stdWord << "  " << *myWord << std::endl;
+
+//  FLAT MAP / FLAT SET
+	std::cout << "=========================" << std::endl;
+	std::cout << "   STD     MAP     FLAT  " << std::endl;
+	std::cout << "____________|____________" << std::endl;
+
+	std::map<int, int> stdFlatMap;
+	ft::flat_map<int, int> myFlatMap;
+	ft::vector<ft::pair<int, int> > flatPairs;
+
+	for (int i = 0; i < 50; i++) {
+		stdFlatMap[(i * 13) % 50] = i;
+		flatPairs.push_back(ft::make_pair((i * 13) % 50, i));
+	}
+	myFlatMap.insert(flatPairs.begin(), flatPairs.end());
+	std::cout << "range insert: 50 keys in scattered order" << std::endl;
+	std::cout << "Size: \t" << stdFlatMap.size() << "\t|\t" << myFlatMap.size() << "\n";
+	std::cout << "same elements: " << ft::equal(myFlatMap.begin(), myFlatMap.end(), stdFlatMap.begin(), same_pair()) << std::endl;
+	std::cout << "[13]: \t" << stdFlatMap[13] << "\t|\t" << myFlatMap[13] << "\n";
+	std::cout << "-------------------------" << std::endl;
+
+	std::cout << "erase(it) removes that element: " << std::endl;
+	std::map<int, int>::iterator stdFlatIt = stdFlatMap.find(36);
+	stdFlatMap.erase(stdFlatIt++);
+	ft::flat_map<int, int>::iterator myFlatIt = myFlatMap.erase(myFlatMap.find(36));
+	std::cout << "erase(find(36)): " << stdFlatIt->first << "\t|\t" << myFlatIt->first << "\n";
+	std::cout << "count(36): \t" << stdFlatMap.count(36) << "\t|\t" << myFlatMap.count(36) << "\n";
+	std::cout << "count(13): \t" << stdFlatMap.count(13) << "\t|\t" << myFlatMap.count(13) << "\n";
+	stdFlatMap.erase(stdFlatMap.begin());
+	myFlatMap.erase(myFlatMap.begin());
+	std::cout << "erase(begin()): " << stdFlatMap.begin()->first << "\t|\t" << myFlatMap.begin()->first << "\n";
+	stdFlatMap.erase(stdFlatMap.lower_bound(10), stdFlatMap.lower_bound(40));
+	myFlatMap.erase(myFlatMap.lower_bound(10), myFlatMap.lower_bound(40));
+	std::cout << "erase range [10, 40)" << std::endl;
+	std::cout << "Size: \t" << stdFlatMap.size() << "\t|\t" << myFlatMap.size() << "\n";
+	std::cout << "same elements: " << ft::equal(myFlatMap.begin(), myFlatMap.end(), stdFlatMap.begin(), same_pair()) << std::endl;
+	std::cout << "-------------------------" << std::endl;
+
+	std::map<std::string, int> stdFlatWords;
+	ft::flat_map<std::string, int> myFlatWords;
+
+	for (int i = 0; i < 7; i++) {
+		stdFlatWords[words[i]] += i;
+		myFlatWords[words[i]] += i;
+	}
+	std::cout << "string keys: pear apple fig kiwi plum apple lime" << std::endl;
+	std::map<std::string, int>::iterator stdWordIt = stdFlatWords.find("kiwi");
+	stdFlatWords.erase(stdWordIt++);
+	ft::flat_map<std::string, int>::iterator myWordIt = myFlatWords.erase(myFlatWords.find("kiwi"));
+	std::cout << "erase(find(kiwi)): " << stdWordIt->first << "\t|\t" << myWordIt->first << "\n";
+	std::cout << "key   value  key   value" << std::endl;
+	stdWordIt = stdFlatWords.begin();
+	for (myWordIt = myFlatWords.begin(); myWordIt != myFlatWords.end(); myWordIt++, stdWordIt++)
+		std::cout << stdWordIt->first << "  " << stdWordIt->second << "    " << myWordIt->first << "  " << myWordIt->second << std::endl;
+	std::cout << "-------------------------" << std::endl;
+
+	std::set<std::string> stdFlatSet(words, words + 7);
+	ft::flat_set<std::string> myFlatSet(words, words + 7);
+	std::cout << "flat_set from the same words" << std::endl;
+	std::cout << "Size: \t" << stdFlatSet.size() << "\t|\t" << myFlatSet.size() << "\n";
+	stdWord = stdFlatSet.find("apple");
+	stdFlatSet.erase(stdWord++);
+	ft::flat_set<std::string>::iterator myFlatWord = myFlatSet.erase(myFlatSet.find("apple"));
+	std::cout << "erase(find(apple)): " << *stdWord << "\t|\t" << *myFlatWord << "\n";
+	std::cout << "std   ft" << std::endl;
+	stdWord = stdFlatSet.begin();
+	for (myFlatWord = myFlatSet.begin(); myFlatWord != myFlatSet.end(); myFlatWord++, stdWord++)
+		std::cout << *stdWord << "  " << *myFlatWord << std::endl;
+
+//  UNORDERED MAP / UNORDERED SET
+	std::cout << "=========================" << std::endl;
+	std::cout << "   STD     MAP  UNORDERED" << std::endl;
+	std::cout << "____________|____________" << std::endl;
+
+	std::map<int, int> stdHashMap;
+	ft::unordered_map<int, int> myHashMap;
+
+	for (int i = 0; i < 100; i++) {
+		stdHashMap[i * 16] = i;
+		myHashMap[i * 16] = i;
+	}
+	std::cout << "operator[]: keys 0, 16, 32 ... 1584" << std::endl;
+	std::cout << "Size: \t" << stdHashMap.size() << "\t|\t" << myHashMap.size() << "\n";
+	std::cout << "find(320): \t" << stdHashMap.find(320)->second << "\t|\t" << myHashMap.find(320)->second << "\n";
+	std::cout << "count(321): \t" << stdHashMap.count(321) << "\t|\t" << myHashMap.count(321) << "\n";
+	std::cout << "load_factor <= max_load_factor: " << (myHashMap.load_factor() <= myHashMap.max_load_factor()) << std::endl;
+	std::cout << "-------------------------" << std::endl;
+
+	std::cout << "erase every odd value, then insert 50 new keys: " << std::endl;
+	for (int i = 1; i < 100; i += 2) {
+		stdHashMap.erase(i * 16);
+		myHashMap.erase(i * 16);
+	}
+	for (int i = 0; i < 50; i++) {
+		stdHashMap.insert(std::make_pair(i * 16 + 1, -i));
+		myHashMap.insert(ft::make_pair(i * 16 + 1, -i));
+	}
+	std::cout << "Size: \t" << stdHashMap.size() << "\t|\t" << myHashMap.size() << "\n";
+	int hashMatches = 0;
+	for (std::map<int, int>::iterator it = stdHashMap.begin(); it != stdHashMap.end(); it++) {
+		ft::unordered_map<int, int>::iterator found = myHashMap.find(it->first);
+		hashMatches += found != myHashMap.end() && found->second == it->second;
+	}
+	std::cout << "keys found with the same value: " << hashMatches << std::endl;
+	int hashWalked = 0;
+	for (ft::unordered_map<int, int>::iterator it = myHashMap.begin(); it != myHashMap.end(); it++)
+		hashWalked++;
+	std::cout << "elements walked by the iterators: " << hashWalked << std::endl;
+	std::cout << "-------------------------" << std::endl;
+
+	std::cout << "max_load_factor(0.05), then 40 inserts: " << std::endl;
+	ft::unordered_map<int, int> sparseHashMap;
+	sparseHashMap.max_load_factor(0.05f);
+	for (int i = 0; i < 40; i++)
+		sparseHashMap[i] = i;
+	std::cout << "size: " << sparseHashMap.size() << std::endl;
+	std::cout << "load_factor <= 0.05: " << (sparseHashMap.load_factor() <= 0.05f) << std::endl;
+	std::cout << "-------------------------" << std::endl;
+
+	std::set<std::string> stdHashSet(words, words + 7);
+	ft::unordered_set<std::string> myHashSet(words, words + 7);
+	std::cout << "unordered_set from pear apple fig kiwi plum apple lime" << std::endl;
+	std::cout << "Size: \t" << stdHashSet.size() << "\t|\t" << myHashSet.size() << "\n";
+	std::cout << "erase(fig): \t" << stdHashSet.erase("fig") << "\t|\t" << myHashSet.erase("fig") << "\n";
+	std::cout << "erase(fig): \t" << stdHashSet.erase("fig") << "\t|\t" << myHashSet.erase("fig") << "\n";
+	std::cout << "std   ft count" << std::endl;
+	for (stdWord = stdHashSet.begin(); stdWord != stdHashSet.end(); stdWord++)
+		std::cout << *stdWord << "  " << myHashSet.count(*stdWord) << std::endl;
+
+//  CONCURRENT MAP
+	std::cout << "=========================" << std::endl;
+	std::cout << "   STD   MAP  CONCURRENT " << std::endl;
+	std::cout << "____________|____________" << std::endl;
+
+	std::map<int, int> stdSharedMap;
+	ft::concurrent_map<int, int> mySharedMap(8);
+	concurrent_fill fills[2];
+	pthread_t fillers[2];
+
+	for (int i = 0; i < 400; i++)
+		stdSharedMap.insert(std::make_pair(i * 16, i));
+	for (int t = 0; t < 2; t++) {
+		fills[t].map = &mySharedMap;
+		fills[t].first = t;
+		pthread_create(&fillers[t], 0, fill_concurrent, &fills[t]);
+	}
+	for (int t = 0; t < 2; t++)
+		pthread_join(fillers[t], 0);
+	std::cout << "2 threads insert keys 0, 16, 32 ... 6384" << std::endl;
+	std::cout << "Size: \t" << stdSharedMap.size() << "\t|\t" << mySharedMap.size() << "\n";
+	std::cout << "shards: " << mySharedMap.shard_count() << std::endl;
+	int sharedValue = -1;
+	mySharedMap.find(320, sharedValue);
+	std::cout << "find(320): \t" << stdSharedMap.find(320)->second << "\t|\t" << sharedValue << "\n";
+	std::cout << "contains(321): \t" << stdSharedMap.count(321) << "\t|\t" << mySharedMap.contains(321) << "\n";
+	std::cout << "-------------------------" << std::endl;
+
+	std::cout << "insert / insert_or_assign / erase: " << std::endl;
+	std::cout << "insert(32, 0): \t" << stdSharedMap.insert(std::make_pair(32, 0)).second << "\t|\t" << mySharedMap.insert(ft::make_pair(32, 0)) << "\n";
+	stdSharedMap[32] = 99;
+	std::cout << "insert_or_assign(32, 99): " << mySharedMap.insert_or_assign(32, 99) << std::endl;
+	mySharedMap.find(32, sharedValue);
+	std::cout << "find(32): \t" << stdSharedMap[32] << "\t|\t" << sharedValue << "\n";
+	std::cout << "erase(48): \t" << stdSharedMap.erase(48) << "\t|\t" << mySharedMap.erase(48) << "\n";
+	std::cout << "erase(48): \t" << stdSharedMap.erase(48) << "\t|\t" << mySharedMap.erase(48) << "\n";
+	std::cout << "Size: \t" << stdSharedMap.size() << "\t|\t" << mySharedMap.size() << "\n";
+	std::cout << "-------------------------" << std::endl;
+
+	std::cout << "for_each_in_range [0, 100): " << std::endl;
+	collect_keys sharedKeys = mySharedMap.for_each_in_range(0, 100, collect_keys());
+	std::map<int, int>::iterator stdShared = stdSharedMap.begin();
+	std::cout << "std   ft" << std::endl;
+	for (size_t n = 0; n < sharedKeys.keys.size(); n++, stdShared++)
+		std::cout << stdShared->first << "     " << sharedKeys.keys[n] << std::endl;
+	sharedKeys = mySharedMap.for_each_in_range(0, 7000, collect_keys());
+	bool sharedInOrder = sharedKeys.keys.size() == stdSharedMap.size();
+	stdShared = stdSharedMap.begin();
+	for (size_t n = 0; sharedInOrder && n < sharedKeys.keys.size(); n++, stdShared++)
+		sharedInOrder = stdShared->first == sharedKeys.keys[n];
+	std::cout << "whole range in order: " << sharedInOrder << std::endl;
+	mySharedMap.clear();
+	std::cout << "clear, empty(): " << mySharedMap.empty() << std::endl;
+
+//  PERSISTENT MAP
+	std::cout << "=========================" << std::endl;
+	std::cout << "   STD   MAP  PERSISTENT " << std::endl;
+	std::cout << "____________|____________" << std::endl;
+
+	std::map<int, int> stdVersionMap;
+	ft::persistent_map<int, int> myVersionMap;
+
+	for (int i = 0; i < 8; i++) {
+		stdVersionMap.insert(std::make_pair(i, i * 10));
+		myVersionMap.insert(ft::make_pair(i, i * 10));
+	}
+	std::cout << "insert: 0 .. 7, value key * 10" << std::endl;
+	std::cout << "Size: \t" << stdVersionMap.size() << "\t|\t" << myVersionMap.size() << "\n";
+	std::map<int, int> stdFirstVersion(stdVersionMap);
+	ft::persistent_map<int, int> myFirstVersion = myVersionMap.snapshot();
+	std::cout << "first version = snapshot()" << std::endl;
+	std::cout << "-------------------------" << std::endl;
+
+	std::cout << "insert(8) / erase(3) / insert_or_assign(5, 500): " << std::endl;
+	stdVersionMap.insert(std::make_pair(8, 80));
+	myVersionMap.insert(ft::make_pair(8, 80));
+	std::cout << "erase(3): \t" << stdVersionMap.erase(3) << "\t|\t" << myVersionMap.erase(3) << "\n";
+	stdVersionMap[5] = 500;
+	std::cout << "insert_or_assign(5, 500): " << myVersionMap.insert_or_assign(5, 500) << std::endl;
+	std::cout << "insert_or_assign(9, 90): " << myVersionMap.insert_or_assign(9, 90) << std::endl;
+	stdVersionMap[9] = 90;
+	std::cout << "current version:" << std::endl;
+	std::cout << "key   value  key   value" << std::endl;
+	std::map<int, int>::iterator stdVersion = stdVersionMap.begin();
+	ft::persistent_map<int, int>::const_iterator myVersion = myVersionMap.begin();
+	for (; stdVersion != stdVersionMap.end() and myVersion != myVersionMap.end(); stdVersion++, myVersion++) {
+		std::cout << stdVersion->first << "     " << stdVersion->second << "      " <<  myVersion->first << "     " << myVersion->second << std::endl;
+	}
+	std::cout << "first version, untouched:" << std::endl;
+	std::cout << "key   value  key   value" << std::endl;
+	stdVersion = stdFirstVersion.begin();
+	myVersion = myFirstVersion.begin();
+	for (; stdVersion != stdFirstVersion.end() and myVersion != myFirstVersion.end(); stdVersion++, myVersion++) {
+		std::cout << stdVersion->first << "     " << stdVersion->second << "      " <<  myVersion->first << "     " << myVersion->second << std::endl;
+	}
+	std::cout << "Size: \t" << stdFirstVersion.size() << "\t|\t" << myFirstVersion.size() << "\n";
+	std::cout << "-------------------------" << std::endl;
+
+	std::cout << "lookups in both versions: " << std::endl;
+	std::cout << "count(3): \t" << stdVersionMap.count(3) << "\t|\t" << myVersionMap.count(3) << "\n";
+	std::cout << "first count(3): " << stdFirstVersion.count(3) << "\t|\t" << myFirstVersion.count(3) << "\n";
+	std::cout << "find(5): \t" << stdVersionMap.find(5)->second << "\t|\t" << myVersionMap.find(5)->second << "\n";
+	std::cout << "first find(5): \t" << stdFirstVersion.find(5)->second << "\t|\t" << myFirstVersion.find(5)->second << "\n";
+	std::cout << "lower_bound(3): " << stdVersionMap.lower_bound(3)->first << "\t|\t" << myVersionMap.lower_bound(3)->first << "\n";
+	std::cout << "upper_bound(5): " << stdVersionMap.upper_bound(5)->first << "\t|\t" << myVersionMap.upper_bound(5)->first << "\n";
+	std::cout << "-------------------------" << std::endl;
+
+	std::cout << "copy, then clear() the original: " << std::endl;
+	std::map<int, int> stdSecondVersion(stdVersionMap);
+	ft::persistent_map<int, int> mySecondVersion(myVersionMap);
+	stdVersionMap.clear();
+	myVersionMap.clear();
+	std::cout << "Size: \t" << stdVersionMap.size() << "\t|\t" << myVersionMap.size() << "\n";
+	std::cout << "copy Size: \t" << stdSecondVersion.size() << "\t|\t" << mySecondVersion.size() << "\n";
+	std::cout << "copy same elements: " << ft::equal(mySecondVersion.begin(), mySecondVersion.end(), stdSecondVersion.begin(), same_pair()) << std::endl;
+	std::cout << "first same elements: " << ft::equal(myFirstVersion.begin(), myFirstVersion.end(), stdFirstVersion.begin(), same_pair()) << std::endl;
+	std::cout << "-------------------------" << std::endl;
 	return 0;
  }
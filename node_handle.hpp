@@ -0,0 +1,146 @@
+#pragma once
+
+#include "pair.hpp"
+#include "pool.hpp"
+#include "utils.hpp"
+
+namespace ft {
+//	Owns a node taken out of a map or a set by extract(), value and all, until insert() links it into a container again.
+//	A handle that still holds its node when it goes away destroys the value.
+//	Before C++11 copies hand the node over like std::auto_ptr and leave the source empty, so handles can be returned and passed by value.
+//	From C++11 they are move-only.
+    template <class Value, class NodeAlloc>
+    class node_handle_base {
+    public:
+        typedef typename NodeAlloc::template rebind<Value>::other			allocator_type;
+        typedef typename NodeAlloc::pointer									node_ptr;
+        typedef ft::node_pool<typename NodeAlloc::value_type, NodeAlloc>	pool_type;
+        typedef typename pool_type::pin_type								pin_type;
+    protected:
+        mutable node_ptr	_node;
+        mutable pin_type	_pin;
+        NodeAlloc			_alloc;
+
+        void reset() {
+            if (_node) {
+                _alloc.destroy(_node);
+                pool_type::discard(_node, _pin, _alloc);
+                _node = 0;
+                _pin = 0;
+            }
+        }
+
+    public:
+        node_handle_base() : _node(0), _pin(0), _alloc() {}
+
+        node_handle_base(node_ptr node, pin_type pin, const NodeAlloc& alloc) : _node(node), _pin(pin), _alloc(alloc) {}
+
+#if __cplusplus >= 201103L
+        node_handle_base(node_handle_base&& other) : _node(0), _pin(0), _alloc(other._alloc) {
+            other.give(*this);
+        }
+
+        node_handle_base& operator=(node_handle_base&& other) {
+            if (this != &other)
+                other.give(*this);
+            return *this;
+        }
+
+        node_handle_base(const node_handle_base&) = delete;
+        node_handle_base& operator=(const node_handle_base&) = delete;
+#else
+        node_handle_base(const node_handle_base& other) : _node(0), _pin(0), _alloc(other._alloc) {
+            other.give(*this);
+        }
+
+        node_handle_base& operator=(const node_handle_base& other) {
+            if (this != &other)
+                other.give(*this);
+            return *this;
+        }
+#endif
+
+        ~node_handle_base() {
+            reset();
+        }
+
+        bool empty() const {
+            return !_node;
+        }
+
+        allocator_type get_allocator() const {
+            return allocator_type(_alloc);
+        }
+
+        void swap(node_handle_base& other) {
+            node_ptr node = _node;
+            pin_type pin = _pin;
+            NodeAlloc alloc = _alloc;
+            _node = other._node;
+            _pin = other._pin;
+            _alloc = other._alloc;
+            other._node = node;
+            other._pin = pin;
+            other._alloc = alloc;
+        }
+
+//		For the containers: the node and the pin of its arenas, release() lets go of both once the node is linked into a tree that adopted the pin.
+        node_ptr node() const {
+            return _node;
+        }
+
+        pin_type pin() const {
+            return _pin;
+        }
+
+        void release() const {
+            pool_type::unpin(_pin, _alloc);
+            _node = 0;
+            _pin = 0;
+        }
+
+//		Moves the node into to, dropping whatever to held.
+        void give(node_handle_base& to) const {
+            to.reset();
+            to._node = _node;
+            to._pin = _pin;
+            to._alloc = _alloc;
+            _node = 0;
+            _pin = 0;
+        }
+    };
+
+    template <class Value, class NodeAlloc>
+    class set_node_handle : public node_handle_base<Value, NodeAlloc> {
+    public:
+        typedef Value	value_type;
+
+        set_node_handle() {}
+
+        set_node_handle(typename set_node_handle::node_ptr node, typename set_node_handle::pin_type pin, const NodeAlloc& alloc) : node_handle_base<Value, NodeAlloc>(node, pin, alloc) {}
+
+        value_type& value() const {
+            return this->_node->pair;
+        }
+    };
+
+//	key() may be assigned while the node is out of any map, the way to change the key of an element.
+    template <class Value, class NodeAlloc>
+    class map_node_handle : public node_handle_base<Value, NodeAlloc> {
+    public:
+        typedef typename ft::switch_const<typename Value::first_type>::type	key_type;
+        typedef typename Value::second_type									mapped_type;
+
+        map_node_handle() {}
+
+        map_node_handle(typename map_node_handle::node_ptr node, typename map_node_handle::pin_type pin, const NodeAlloc& alloc) : node_handle_base<Value, NodeAlloc>(node, pin, alloc) {}
+
+        key_type& key() const {
+            return const_cast<key_type&>(this->_node->pair.first);
+        }
+
+        mapped_type& mapped() const {
+            return this->_node->pair.second;
+        }
+    };
+}
@@ -1,8 +1,59 @@
 #pragma once
 
+#include "utils.hpp"
+
 namespace ft {
+#ifdef FT_ORDER_STATISTICS
+//	Number of nodes in the subtree, kept up to date by Tree for rank and select.
+    struct node_count {
+        size_t	count;
+
+        node_count() : count(1) {}
+    };
+#else
+    struct node_count {};
+#endif
+
+//	Tree node. Build with -DFT_COMPACT_NODE for the compact layout: the links come before the value so a descent reads one cache line,
+//	and the colour is the low bit of parent (set means black), which removes the padded bool. Tree and iterators go through the accessors;
+//	the raw parent field is only read directly on a header node, which has no colour.
     template <class Node>
-    struct node {
+    struct node : public node_count {
+#ifdef FT_COMPACT_NODE
+        node*		left;
+        node*		right;
+		node*		parent;
+        Node		pair;
+
+        node() : left(0), right(0), parent(0), pair(Node()) {}
+
+		node(const Node& p_pair) : left(0), right(0), parent(0), pair(p_pair) {}
+
+		node& operator=(const node& node) {
+            node_count::operator=(node);
+            pair = node.pair;
+            left = node.left;
+            right = node.right;
+			parent = node.parent;
+            return *this;
+        }
+
+        node* get_parent() const {
+            return reinterpret_cast<node*>(reinterpret_cast<size_t>(parent) & ~size_t(1));
+        }
+
+        void set_parent(node* some) {
+            parent = reinterpret_cast<node*>(reinterpret_cast<size_t>(some) | (reinterpret_cast<size_t>(parent) & 1));
+        }
+
+        bool is_black() const {
+            return reinterpret_cast<size_t>(parent) & 1;
+        }
+
+        void set_black(bool black) {
+            parent = reinterpret_cast<node*>((reinterpret_cast<size_t>(parent) & ~size_t(1)) | size_t(black));
+        }
+#else
         Node		pair;
         node*		left;
         node*		right;
@@ -14,6 +65,7 @@ namespace ft {
 		node(const Node& p_pair) : pair(p_pair), left(0), right(0), parent(0), isBlack(false) {}
 
 		node& operator=(const node& node) {
+            node_count::operator=(node);
             pair = node.pair;
             left = node.left;
             right = node.right;
@@ -21,6 +73,23 @@ namespace ft {
             isBlack = node.isBlack;
             return *this;
         }
+
+        node* get_parent() const {
+            return parent;
+        }
+
+        void set_parent(node* some) {
+            parent = some;
+        }
+
+        bool is_black() const {
+            return isBlack;
+        }
+
+        void set_black(bool black) {
+            isBlack = black;
+        }
+#endif
     };
 
     template <class Key, class Val>
@@ -37,6 +106,8 @@ namespace ft {
 
         pair(const first_type &a, const second_type &b) : first(a), second(b) {}
 
+        pair(const pair &other) : first(other.first), second(other.second) {}
+
         pair &operator=(const pair &other) {
             first = other.first;
             second = other.second;
@@ -44,6 +115,10 @@ namespace ft {
         }
     };
 
+//	A pair of trivially relocatable members can be relocated with memcpy as well.
+    template <class T1, class T2>
+    struct is_trivially_relocatable<pair<T1, T2> > : public ft::integral_constant<bool, is_trivially_relocatable<T1>::value && is_trivially_relocatable<T2>::value> {};
+
     template <class T1, class T2>
     bool operator==(const pair <T1, T2>& lhs, const pair <T1, T2>& rhs) {
         return lhs.first == rhs.first && lhs.second == rhs.second;
@@ -0,0 +1,715 @@
+#pragma once
+
+#include <new>
+#include <pthread.h>
+#include "utils.hpp"
+#include "pair.hpp"
+
+namespace ft {
+//	Node of a persistent_map, shared by every version that reaches it and freed by whoever drops the last reference.
+//	There is no parent link, a node has as many parents as versions it belongs to. The reference count and the colour share a word, 40 bytes for an int pair.
+    template <class Value>
+    struct persistent_node {
+        persistent_node*	left;
+        persistent_node*	right;
+        size_t				count;
+        unsigned			refs;
+        bool				black;
+        Value				value;
+
+        explicit persistent_node(const Value& val) : left(0), right(0), count(1), refs(1), black(false), value(val) {}
+    };
+
+//	Walks one version of a persistent_map in order, keeping the nodes still to visit on a stack since nodes have no parent.
+//	A red-black tree of n nodes is at most 2 log2(n + 1) high, so twice the bits of a size_t is always enough.
+//	It stays valid as long as some map holds the version it came from.
+    template <class Value>
+    class persistent_iterator {
+    public:
+        typedef std::ptrdiff_t					difference_type;
+        typedef Value							value_type;
+        typedef const Value*					pointer;
+        typedef const Value&					reference;
+        typedef std::forward_iterator_tag		iterator_category;
+        typedef persistent_node<Value>			node_type;
+    private:
+        static const size_t	max_height = sizeof(size_t) * 16;
+
+        const node_type*	_stack[max_height];
+        size_t				_depth;
+    public:
+        persistent_iterator() : _depth(0) {}
+
+        persistent_iterator(const persistent_iterator& other) : _depth(other._depth) {
+            for (size_t i = 0; i < _depth; ++i)
+                _stack[i] = other._stack[i];
+        }
+
+        ~persistent_iterator() {}
+
+        persistent_iterator& operator=(const persistent_iterator& other) {
+            _depth = other._depth;
+            for (size_t i = 0; i < _depth; ++i)
+                _stack[i] = other._stack[i];
+            return *this;
+        }
+
+        void push(const node_type* some) {
+            _stack[_depth++] = some;
+        }
+
+        void push_left(const node_type* some) {
+            for (; some; some = some->left)
+                push(some);
+        }
+
+//		Node the iterator is on, 0 at the end.
+        const node_type* node() const {
+            return _depth ? _stack[_depth - 1] : 0;
+        }
+
+        reference operator*() const {
+            return _stack[_depth - 1]->value;
+        }
+
+        pointer operator->() const {
+            return &_stack[_depth - 1]->value;
+        }
+
+        persistent_iterator& operator++() {
+            const node_type* some = _stack[--_depth];
+            push_left(some->right);
+            return *this;
+        }
+
+        persistent_iterator operator++(int) {
+            persistent_iterator tmp(*this);
+            ++(*this);
+            return tmp;
+        }
+    };
+
+    template <class Value>
+    bool operator==(const persistent_iterator<Value>& a, const persistent_iterator<Value>& b) {
+        return a.node() == b.node();
+    }
+
+    template <class Value>
+    bool operator!=(const persistent_iterator<Value>& a, const persistent_iterator<Value>& b) {
+        return !(a == b);
+    }
+
+//	Immutable ordered map whose versions share their nodes: an update copies the O(log n) nodes on its path from the root,
+//	rebalances the copy with the red-black rules of tree.hpp and shares every other node through atomic reference counts.
+//	Copying a map, or taking a snapshot() of one that another thread is updating, retains its root in O(1), and the copy never sees later updates.
+//	Readers take no lock: a snapshot counts itself in while it loads and retains the root, and an update that swapped the root
+//	waits for that count to drain, a few instructions, before it releases the old one.
+//	Updates of one map are serialised by its mutex. Lookups and iteration are for maps no other thread updates, i.e. snapshots.
+//	The last reference to a node may go in any thread, so Alloc must take frees from any thread, which the pool of ft::map does not.
+    template <class Key, class T, class Compare = ft::less<Key>, class Alloc = std::allocator <ft::pair<const Key, T> > >
+    class persistent_map {
+    public:
+        typedef Key										key_type;
+        typedef T										mapped_type;
+        typedef ft::pair<const Key, T>					value_type;
+        typedef Compare									key_compare;
+        typedef Alloc									allocator_type;
+        typedef const value_type&						reference;
+        typedef const value_type&						const_reference;
+        typedef ft::persistent_iterator<value_type>		const_iterator;
+        typedef const_iterator							iterator;
+        typedef size_t									size_type;
+        typedef std::ptrdiff_t							difference_type;
+    private:
+        typedef ft::persistent_node<value_type>							node_type;
+        typedef typename Alloc::template rebind<node_type>::other		node_allocator;
+
+        static const size_t	max_height = sizeof(size_t) * 16;
+
+//		New version under construction: released on the way out unless it was published.
+        class draft {
+            persistent_map*	_owner;
+
+            draft(const draft&);
+            draft& operator=(const draft&);
+        public:
+            node_type*	root;
+
+            draft(persistent_map* owner, node_type* some) : _owner(owner), root(some) {}
+
+            ~draft() {
+                _owner->release(root);
+            }
+
+            node_type* publish() {
+                node_type* some = root;
+                root = 0;
+                return some;
+            }
+        };
+
+        class write_lock {
+            pthread_mutex_t*	_lock;
+
+            write_lock(const write_lock&);
+            write_lock& operator=(const write_lock&);
+        public:
+            explicit write_lock(pthread_mutex_t* lock) : _lock(lock) {
+                pthread_mutex_lock(_lock);
+            }
+
+            ~write_lock() {
+                pthread_mutex_unlock(_lock);
+            }
+        };
+
+        node_type*				_root;
+        mutable size_t			_readers;
+        pthread_mutex_t			_lock;
+        key_compare				_k_comp;
+        allocator_type			_alloc;
+
+        persistent_map(node_type* root, const key_compare& comp, const allocator_type& alloc) : _root(root), _readers(0), _k_comp(comp), _alloc(alloc) {
+            pthread_mutex_init(&_lock, 0);
+        }
+
+        static size_t count_of(const node_type* some) {
+            return some ? some->count : 0;
+        }
+
+        static node_type* retain(node_type* some) {
+            if (some)
+                __atomic_add_fetch(&some->refs, 1, __ATOMIC_RELAXED);
+            return some;
+        }
+
+//		Recurses into left subtrees and loops down the right spine, so the depth stays within the height.
+        void release(node_type* some) {
+            while (some && __atomic_sub_fetch(&some->refs, 1, __ATOMIC_ACQ_REL) == 0) {
+                node_type* right = some->right;
+                release(some->left);
+                some->~node_type();
+                node_allocator(_alloc).deallocate(some, 1);
+                some = right;
+            }
+        }
+
+//		New node for val in the place of some: same colour and subtree size, and a share of its children.
+        node_type* copy(const node_type* some, const value_type& val) {
+            node_allocator alloc(_alloc);
+            node_type* fresh = alloc.allocate(1);
+
+            try {
+                ::new(static_cast<void*>(fresh)) node_type(val);
+            } catch (...) {
+                alloc.deallocate(fresh, 1);
+                throw;
+            }
+            fresh->black = some->black;
+            fresh->count = some->count;
+            fresh->left = retain(some->left);
+            fresh->right = retain(some->right);
+            return fresh;
+        }
+
+        node_type* create(const value_type& val) {
+            node_allocator alloc(_alloc);
+            node_type* fresh = alloc.allocate(1);
+
+            try {
+                ::new(static_cast<void*>(fresh)) node_type(val);
+            } catch (...) {
+                alloc.deallocate(fresh, 1);
+                throw;
+            }
+            return fresh;
+        }
+
+//		Makes the node link points to private to the draft before it is changed.
+//		A node with a single reference is reachable from the draft only: made for it, or let go by every other version.
+        void unshare(node_type*& link) {
+            if (__atomic_load_n(&link->refs, __ATOMIC_ACQUIRE) != 1) {
+                node_type* fresh = copy(link, link->value);
+                release(link);
+                link = fresh;
+            }
+        }
+
+//		Loads and retains the root while counted as a reader, so that an update cannot release it in between.
+//		Sequentially consistent against publish(): either publish() sees this reader counted in, or this reader sees the new root.
+        node_type* acquire() const {
+            __atomic_add_fetch(&_readers, 1, __ATOMIC_SEQ_CST);
+            node_type* root = retain(__atomic_load_n(&_root, __ATOMIC_SEQ_CST));
+            __atomic_sub_fetch(&_readers, 1, __ATOMIC_RELEASE);
+            return root;
+        }
+
+//		Swaps in the new root, waits for the readers that may have loaded the old one and lets go of it.
+        void publish(node_type* root) {
+            node_type* old = __atomic_exchange_n(&_root, root, __ATOMIC_SEQ_CST);
+
+            while (__atomic_load_n(&_readers, __ATOMIC_SEQ_CST))
+                ft::spin_pause();
+            release(old);
+        }
+
+        const node_type* lookup(const node_type* some, const key_type& k) const {
+            while (some) {
+                if (_k_comp(k, some->value.first))
+                    some = some->left;
+                else if (_k_comp(some->value.first, k))
+                    some = some->right;
+                else
+                    return some;
+            }
+            return 0;
+        }
+
+//		Link that holds some: the root, or a child of path[depth - 1].
+        static node_type*& link_of(node_type*& root, node_type** path, size_t depth, node_type* some) {
+            if (!depth)
+                return root;
+            if (path[depth - 1]->left == some)
+                return path[depth - 1]->left;
+            return path[depth - 1]->right;
+        }
+
+//		Rotations only relink nodes of the draft and return the new top, the callers hang it and set the colours.
+        static node_type* rotate_left(node_type* some) {
+            node_type* right = some->right;
+
+            some->right = right->left;
+            right->left = some;
+            right->count = some->count;
+            some->count = count_of(some->left) + count_of(some->right) + 1;
+            return right;
+        }
+
+        static node_type* rotate_right(node_type* some) {
+            node_type* left = some->left;
+
+            some->left = left->right;
+            left->right = some;
+            left->count = some->count;
+            some->count = count_of(some->left) + count_of(some->right) + 1;
+            return left;
+        }
+
+//		Copies the path down to where val belongs, links a red node for it there and rebalances. val must not be in the draft.
+        void insert_path(node_type*& root, const value_type& val) {
+            node_type* path[max_height];
+            size_t depth = 0;
+            node_type** link = &root;
+
+            while (*link) {
+                unshare(*link);
+                path[depth++] = *link;
+                link = _k_comp(val.first, (*link)->value.first) ? &(*link)->left : &(*link)->right;
+            }
+            *link = create(val);
+            for (size_t i = 0; i < depth; ++i)
+                ++path[i]->count;
+            path[depth++] = *link;
+            insert_balance(root, path, depth);
+        }
+
+//		Tree::insert_balance with the parents read from the path: recolours while the uncle is red, otherwise rotates once or twice under the grandparent.
+        void insert_balance(node_type*& root, node_type** path, size_t depth) {
+            size_t i = depth - 1;
+
+            while (i > 0 && !path[i - 1]->black) {
+                node_type* some = path[i];
+                node_type* parent = path[i - 1];
+                node_type* grand = path[i - 2];
+                bool left = grand->left == parent;
+                node_type*& uncle = left ? grand->right : grand->left;
+                if (uncle && !uncle->black) {
+                    unshare(uncle);
+                    parent->black = true;
+                    uncle->black = true;
+                    grand->black = false;
+                    i -= 2;
+                }
+                else {
+                    if (left) {
+                        if (parent->right == some) {
+                            grand->left = rotate_left(parent);
+                            parent = some;
+                        }
+                        link_of(root, path, i - 2, grand) = rotate_right(grand);
+                    }
+                    else {
+                        if (parent->left == some) {
+                            grand->right = rotate_right(parent);
+                            parent = some;
+                        }
+                        link_of(root, path, i - 2, grand) = rotate_left(grand);
+                    }
+                    parent->black = true;
+                    grand->black = false;
+                    break;
+                }
+            }
+            root->black = true;
+        }
+
+//		Copies the path down to the node of k, and on to its successor when it has two children, then unlinks it like Tree::unlink_node. k must be in the draft.
+        void erase_path(node_type*& root, const key_type& k) {
+            node_type* path[max_height];
+            size_t depth = 0;
+            node_type** link = &root;
+
+            for (;;) {
+                unshare(*link);
+                path[depth++] = *link;
+                if (_k_comp(k, (*link)->value.first))
+                    link = &(*link)->left;
+                else if (_k_comp((*link)->value.first, k))
+                    link = &(*link)->right;
+                else
+                    break;
+            }
+            size_t at = depth - 1;
+            node_type* some = path[at];
+            if (some->left && some->right) {
+                link = &some->right;
+                for (;;) {
+                    unshare(*link);
+                    path[depth++] = *link;
+                    if (!(*link)->left)
+                        break;
+                    link = &(*link)->left;
+                }
+            }
+            for (size_t i = 0; i < depth; ++i)
+                --path[i]->count;
+            node_type* moved = path[depth - 1];
+            node_type* child;
+            bool removed_black;
+            if (moved == some) {
+                child = some->left ? some->left : some->right;
+                link_of(root, path, at, some) = child;
+                removed_black = some->black;
+                depth = at;
+            }
+            else {
+                child = moved->right;
+                moved->left = some->left;
+                if (moved != some->right) {
+                    path[depth - 2]->left = child;
+                    moved->right = some->right;
+                }
+                --depth;
+                link_of(root, path, at, some) = moved;
+                path[at] = moved;
+                removed_black = moved->black;
+                moved->black = some->black;
+                moved->count = some->count;
+            }
+            some->left = 0;
+            some->right = 0;
+            release(some);
+            if (removed_black)
+                erase_balance(root, path, depth, child);
+        }
+
+//		Tree::erase_balance with the parents read from the path: the path through some, a child of path[depth - 1], is one black short.
+//		Every brother gets changed, so it is copied first, and so is a nephew that gets recoloured.
+        void erase_balance(node_type*& root, node_type** path, size_t depth, node_type* some) {
+            while (depth > 0 && (!some || some->black)) {
+                node_type* parent = path[depth - 1];
+                if (some == parent->left) {
+                    unshare(parent->right);
+                    if (!parent->right->black) {
+                        node_type* brother = parent->right;
+                        brother->black = true;
+                        parent->black = false;
+                        link_of(root, path, depth - 1, parent) = rotate_left(parent);
+                        path[depth - 1] = brother;
+                        path[depth++] = parent;
+                        unshare(parent->right);
+                    }
+                    node_type* brother = parent->right;
+                    if ((!brother->left || brother->left->black) && (!brother->right || brother->right->black)) {
+                        brother->black = false;
+                        some = parent;
+                        --depth;
+                    }
+                    else {
+                        if (!brother->right || brother->right->black) {
+                            unshare(brother->left);
+                            brother->left->black = true;
+                            brother->black = false;
+                            parent->right = rotate_right(brother);
+                            brother = parent->right;
+                        }
+                        brother->black = parent->black;
+                        parent->black = true;
+                        if (brother->right) {
+                            unshare(brother->right);
+                            brother->right->black = true;
+                        }
+                        link_of(root, path, depth - 1, parent) = rotate_left(parent);
+                        return;
+                    }
+                }
+                else {
+                    unshare(parent->left);
+                    if (!parent->left->black) {
+                        node_type* brother = parent->left;
+                        brother->black = true;
+                        parent->black = false;
+                        link_of(root, path, depth - 1, parent) = rotate_right(parent);
+                        path[depth - 1] = brother;
+                        path[depth++] = parent;
+                        unshare(parent->left);
+                    }
+                    node_type* brother = parent->left;
+                    if ((!brother->right || brother->right->black) && (!brother->left || brother->left->black)) {
+                        brother->black = false;
+                        some = parent;
+                        --depth;
+                    }
+                    else {
+                        if (!brother->left || brother->left->black) {
+                            unshare(brother->right);
+                            brother->right->black = true;
+                            brother->black = false;
+                            parent->left = rotate_left(brother);
+                            brother = parent->left;
+                        }
+                        brother->black = parent->black;
+                        parent->black = true;
+                        if (brother->left) {
+                            unshare(brother->left);
+                            brother->left->black = true;
+                        }
+                        link_of(root, path, depth - 1, parent) = rotate_right(parent);
+                        return;
+                    }
+                }
+            }
+            if (some && !some->black) {
+                node_type*& link = link_of(root, path, depth, some);
+                unshare(link);
+                link->black = true;
+            }
+        }
+
+//		Copies the path down to the node of k and puts a node holding obj in its place. k must be in the draft.
+        void assign_path(node_type*& root, const key_type& k, const mapped_type& obj) {
+            node_type** link = &root;
+
+            for (;;) {
+                if (_k_comp(k, (*link)->value.first)) {
+                    unshare(*link);
+                    link = &(*link)->left;
+                }
+                else if (_k_comp((*link)->value.first, k)) {
+                    unshare(*link);
+                    link = &(*link)->right;
+                }
+                else
+                    break;
+            }
+            node_type* old = *link;
+            *link = copy(old, value_type(old->value.first, obj));
+            release(old);
+        }
+
+    public:
+        explicit persistent_map(const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type()) : _root(0), _readers(0), _k_comp(comp), _alloc(alloc) {
+            pthread_mutex_init(&_lock, 0);
+        }
+
+        template <class InputIterator>
+        persistent_map(InputIterator first, InputIterator last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type()) : _root(0), _readers(0), _k_comp(comp), _alloc(alloc) {
+            pthread_mutex_init(&_lock, 0);
+            try {
+                insert(first, last);
+            } catch (...) {
+                pthread_mutex_destroy(&_lock);
+                throw;
+            }
+        }
+
+//		O(1): shares the current version of other, even while another thread updates it.
+        persistent_map(const persistent_map& other) : _root(other.acquire()), _readers(0), _k_comp(other._k_comp), _alloc(other._alloc) {
+            pthread_mutex_init(&_lock, 0);
+        }
+
+//		No snapshot may be in the middle of being taken from this map any more.
+        ~persistent_map() {
+            release(_root);
+            pthread_mutex_destroy(&_lock);
+        }
+
+//		Publishes the version of other as the new version of this map, in O(1) when the allocators are equal.
+//		Released nodes go back through the allocator of this map, so the version of an other with another allocator is copied into nodes of this one.
+        persistent_map& operator=(const persistent_map& other) {
+            node_type* root;
+
+            if (other._alloc == _alloc)
+                root = other.acquire();
+            else {
+                persistent_map version(other.snapshot());
+                persistent_map copied(version.begin(), version.end(), other._k_comp, _alloc);
+                root = copied._root;
+                copied._root = 0;
+            }
+            write_lock locked(&_lock);
+
+            publish(root);
+            _k_comp = other._k_comp;
+            return *this;
+        }
+
+//		Current version, safe to call while another thread updates this map.
+        persistent_map snapshot() const {
+            return persistent_map(acquire(), _k_comp, _alloc);
+        }
+
+	//	************ iterators *************
+
+        const_iterator begin() const {
+            const_iterator it;
+
+            it.push_left(_root);
+            return it;
+        }
+
+        const_iterator end() const {
+            return const_iterator();
+        }
+
+	//	******** element access *********
+
+        bool empty() const {
+            return _root == 0;
+        }
+
+        size_type size() const {
+            return count_of(_root);
+        }
+
+	//	************ updates **********
+
+//		Each update builds a new version and publishes it in one go: it takes effect entirely or, when it throws, not at all.
+        bool insert(const value_type& val) {
+            write_lock locked(&_lock);
+
+            if (lookup(_root, val.first))
+                return false;
+            draft next(this, retain(_root));
+            insert_path(next.root, val);
+            publish(next.publish());
+            return true;
+        }
+
+//		All of [first, last) goes into one version: nodes copied by an earlier element are private to the draft and changed in place.
+        template <class InputIterator>
+        void insert(InputIterator first, InputIterator last) {
+            write_lock locked(&_lock);
+            draft next(this, retain(_root));
+
+            for (; first != last; ++first) {
+                if (!lookup(next.root, first->first))
+                    insert_path(next.root, *first);
+            }
+            publish(next.publish());
+        }
+
+//		Inserts or overwrites, true when the key was new.
+        bool insert_or_assign(const key_type& k, const mapped_type& obj) {
+            write_lock locked(&_lock);
+            draft next(this, retain(_root));
+            bool inserted = !lookup(_root, k);
+
+            if (inserted)
+                insert_path(next.root, value_type(k, obj));
+            else
+                assign_path(next.root, k, obj);
+            publish(next.publish());
+            return inserted;
+        }
+
+        size_type erase(const key_type& k) {
+            write_lock locked(&_lock);
+
+            if (!lookup(_root, k))
+                return 0;
+            draft next(this, retain(_root));
+            erase_path(next.root, k);
+            publish(next.publish());
+            return 1;
+        }
+
+        void clear() {
+            write_lock locked(&_lock);
+
+            publish(0);
+        }
+
+	//	************ lookups **********
+
+//		The stack keeps the nodes the descent went left from, which come after the one found.
+        const_iterator find(const key_type& k) const {
+            const_iterator it;
+
+            for (const node_type* some = _root; some; ) {
+                if (_k_comp(k, some->value.first)) {
+                    it.push(some);
+                    some = some->left;
+                }
+                else if (_k_comp(some->value.first, k))
+                    some = some->right;
+                else {
+                    it.push(some);
+                    return it;
+                }
+            }
+            return end();
+        }
+
+        size_type count(const key_type& k) const {
+            return lookup(_root, k) ? 1 : 0;
+        }
+
+//		Same stack, the last node pushed is the bound.
+        const_iterator lower_bound(const key_type& k) const {
+            const_iterator it;
+
+            for (const node_type* some = _root; some; ) {
+                if (_k_comp(some->value.first, k))
+                    some = some->right;
+                else {
+                    it.push(some);
+                    some = some->left;
+                }
+            }
+            return it;
+        }
+
+        const_iterator upper_bound(const key_type& k) const {
+            const_iterator it;
+
+            for (const node_type* some = _root; some; ) {
+                if (!_k_comp(k, some->value.first))
+                    some = some->right;
+                else {
+                    it.push(some);
+                    some = some->left;
+                }
+            }
+            return it;
+        }
+
+        key_compare key_comp() const {
+            return _k_comp;
+        }
+
+        allocator_type get_allocator() const {
+            return _alloc;
+        }
+    };
+}
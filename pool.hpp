@@ -0,0 +1,288 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include "utils.hpp"
+
+namespace ft {
+//	Whether Tree carves its nodes out of a node_pool. Specialise it to false for node allocators that already handle single nodes well.
+    template <class Alloc>
+    struct use_node_pool : public ft::true_type {};
+
+//	Fixed-size node pool: nodes are cut out of slabs allocated through Alloc, erased nodes go to an intrusive free list and are reused first.
+//	Slabs double from 16 up to 4096 nodes as the tree grows, and release() gives all of them back at once.
+//	Slabs, free list and cursor make up an arena, which the pools of trees exchanging nodes share: borrow() merges two arenas, so a node freed by either tree is reused by both.
+//	A merged arena forwards to the one it went into, pools and node handles still holding it follow the forward. The slabs are freed by the last one to let go.
+//	Every pool sharing an arena must use equal allocators.
+    template <class T, class Alloc, bool Pooled = ft::use_node_pool<Alloc>::value>
+    class node_pool {
+    private:
+//		Kept in the first node of every slab.
+        struct slab {
+            slab*	next;
+            size_t	count;
+        };
+
+//		Overlays a node that sits in the free list.
+        struct free_slot {
+            free_slot*	next;
+        };
+
+        struct arena {
+            slab*		slabs;
+            free_slot*	free;
+            free_slot*	last_free;
+            T*			cursor;
+            size_t		left;
+            size_t		next_count;
+            size_t		refs;
+            arena*		forward;
+        };
+
+        typedef typename Alloc::template rebind<arena>::other	arena_allocator;
+
+        typedef char node_must_fit_a_slab_header[sizeof(T) >= sizeof(slab) ? 1 : -1];
+
+        static const size_t	first_slab = 16;
+        static const size_t	max_slab = 4096;
+
+        Alloc	_alloc;
+        arena*	_arena;
+
+        node_pool(const node_pool&);
+        node_pool& operator=(const node_pool&);
+
+        static arena* resolve(arena* some) {
+            while (some->forward)
+                some = some->forward;
+            return some;
+        }
+
+//		The arena to allocate from, the pool moves past the forwards left by merges so that it follows them only once.
+        arena* current() {
+            if (!_arena) {
+                _arena = arena_allocator(_alloc).allocate(1);
+                _arena->slabs = 0;
+                _arena->free = 0;
+                _arena->last_free = 0;
+                _arena->cursor = 0;
+                _arena->left = 0;
+                _arena->next_count = first_slab;
+                _arena->refs = 1;
+                _arena->forward = 0;
+            }
+            else if (_arena->forward) {
+                arena* target = resolve(_arena);
+                ++target->refs;
+                drop(_arena, _alloc);
+                _arena = target;
+            }
+            return _arena;
+        }
+
+        void grow(arena* some, size_t count) {
+            T* fresh = _alloc.allocate(count);
+            slab* header = ::new(static_cast<void*>(fresh)) slab;
+
+            header->next = some->slabs;
+            header->count = count;
+            some->slabs = header;
+            some->cursor = fresh + 1;
+            some->left = count - 1;
+        }
+
+        static void push_free(arena* some, T* p) {
+            free_slot* slot = ::new(static_cast<void*>(p)) free_slot;
+
+            slot->next = some->free;
+            if (!some->free)
+                some->last_free = slot;
+            some->free = slot;
+        }
+
+//		Hands the slabs and the free slots of from over to into, which keeps the longer of the two cursors: the other one goes to the free list.
+        static void merge(arena* into, arena* from) {
+            if (from->slabs) {
+                slab* last = from->slabs;
+                while (last->next)
+                    last = last->next;
+                last->next = into->slabs;
+                into->slabs = from->slabs;
+            }
+            if (from->free) {
+                from->last_free->next = into->free;
+                if (!into->free)
+                    into->last_free = from->last_free;
+                into->free = from->free;
+            }
+            if (from->left > into->left) {
+                T* cursor = into->cursor;
+                size_t left = into->left;
+                into->cursor = from->cursor;
+                into->left = from->left;
+                from->cursor = cursor;
+                from->left = left;
+            }
+            for (; from->left; --from->left)
+                push_free(into, from->cursor++);
+            if (from->next_count > into->next_count)
+                into->next_count = from->next_count;
+            from->slabs = 0;
+            from->free = 0;
+            from->cursor = 0;
+            from->forward = into;
+            ++into->refs;
+        }
+
+//		A forwarded arena holds no slabs and a reference on the arena it went into.
+        static void drop(arena* some, Alloc& alloc) {
+            while (some && !--some->refs) {
+                arena* forward = some->forward;
+                while (some->slabs) {
+                    slab* next = some->slabs->next;
+                    alloc.deallocate(reinterpret_cast<T*>(some->slabs), some->slabs->count);
+                    some->slabs = next;
+                }
+                arena_allocator(alloc).deallocate(some, 1);
+                some = forward;
+            }
+        }
+
+    public:
+        typedef arena*	pin_type;
+
+        explicit node_pool(const Alloc& alloc = Alloc()) : _alloc(alloc), _arena(0) {}
+
+        ~node_pool() {
+            release();
+        }
+
+//		Raw memory for one node.
+        T* allocate() {
+            arena* some = current();
+
+            if (some->free) {
+                T* reused = reinterpret_cast<T*>(some->free);
+                some->free = some->free->next;
+                return reused;
+            }
+            if (!some->left) {
+                grow(some, some->next_count);
+                if (some->next_count < max_slab)
+                    some->next_count *= 2;
+            }
+            --some->left;
+            return some->cursor++;
+        }
+
+        void deallocate(T* p) {
+            push_free(current(), p);
+        }
+
+//		Makes sure the next n allocations come from a single slab.
+        void reserve(size_t n) {
+            arena* some = current();
+
+            if (n > some->left)
+                grow(some, n + 1);
+        }
+
+//		Lets go of the arena, its slabs are freed unless another pool or a node handle shares it: the nodes this pool handed out must already be destroyed.
+        void release() {
+            drop(_arena, _alloc);
+            _arena = 0;
+        }
+
+//		Shares one arena with other from now on, so nodes can be handed over to the tree of this pool.
+        void borrow(node_pool& other) {
+            if (&other != this && other._arena)
+                adopt(other.current());
+        }
+
+//		Shares the arena of a pinned node from now on, for a node handle linked into the tree of this pool.
+        void adopt(pin_type pin) {
+            if (!pin)
+                return;
+            arena* from = resolve(pin);
+            if (!_arena) {
+                ++from->refs;
+                _arena = from;
+            }
+            else if (from != current())
+                merge(_arena, from);
+        }
+
+//		Keeps the arena alive until unpin(), for a node leaving the tree in a handle.
+        pin_type pin() {
+            arena* some = current();
+
+            ++some->refs;
+            return some;
+        }
+
+        static void unpin(pin_type pin, Alloc alloc) {
+            drop(pin, alloc);
+        }
+
+//		Memory of a destroyed node nobody links any more: it goes to the free list of the arena, for the pools that share it.
+        static void discard(T* p, pin_type pin, Alloc alloc) {
+            push_free(resolve(pin), p);
+            unpin(pin, alloc);
+        }
+
+        void swap(node_pool& other) {
+            Alloc alloc = _alloc;
+            arena* some = _arena;
+            _alloc = other._alloc;
+            _arena = other._arena;
+            other._alloc = alloc;
+            other._arena = some;
+        }
+    };
+
+//	Pass-through used when pooling is switched off: one allocator call per node.
+    template <class T, class Alloc>
+    class node_pool<T, Alloc, false> {
+    private:
+        Alloc	_alloc;
+
+        node_pool(const node_pool&);
+        node_pool& operator=(const node_pool&);
+    public:
+        typedef void*	pin_type;
+
+        explicit node_pool(const Alloc& alloc = Alloc()) : _alloc(alloc) {}
+
+        T* allocate() {
+            return _alloc.allocate(1);
+        }
+
+        void deallocate(T* p) {
+            _alloc.deallocate(p, 1);
+        }
+
+        void reserve(size_t) {}
+
+        void release() {}
+
+        void borrow(node_pool&) {}
+
+        void adopt(pin_type) {}
+
+        pin_type pin() {
+            return 0;
+        }
+
+        static void unpin(pin_type, Alloc) {}
+
+        static void discard(T* p, pin_type, Alloc alloc) {
+            alloc.deallocate(p, 1);
+        }
+
+        void swap(node_pool& other) {
+            Alloc alloc = _alloc;
+            _alloc = other._alloc;
+            other._alloc = alloc;
+        }
+    };
+}
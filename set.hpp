@@ -1,6 +1,7 @@
 #pragma once
 
 #include "tree.hpp"
+#include "node_handle.hpp"
 #include "iterator.hpp"
 #include "utils.hpp"
 
@@ -27,49 +28,77 @@ namespace ft {
 //		rebind allows to get the type allocator<T> from the type allocator<node>
         typedef typename Alloc::template rebind<node<value_type> >::other	node_allocator_type;
         typedef Tree<value_type , value_compare , node_allocator_type>		tree_type;
+    public:
+        typedef ft::set_node_handle<value_type, node_allocator_type>	node_type;
+
+        struct insert_return_type {
+            iterator	position;
+            bool		inserted;
+            node_type	node;
+        };
+    private:
+#if __cplusplus >= 201103L
+        typedef node_type&&			node_rvalue;
+#else
+        typedef const node_type&	node_rvalue;
+#endif
         typedef ft::node<value_type>*										node_ptr;
         tree_type		_tree;
         node_ptr		_root;
         allocator_type	_alloc;
         key_compare		_k_comp;
         size_type		_size;
+
+//		Return type R for lookups by a key of type K, only when Compare is transparent.
+        template <class K, class R>
+        struct enable_if_transparent : public ft::enable_if<ft::is_transparent<Compare>::value, R> {};
     public:
-        explicit set(const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type()) : _root(0), _alloc(alloc), _k_comp(comp), _size(0) {
-            _root = _tree.create_node(value_type());
+        explicit set(const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type()) : _tree(node_allocator_type(alloc), comp), _root(0), _alloc(alloc), _k_comp(comp), _size(0) {
+            _root = _tree.create_header();
         }
 
         template <class InputIterator>
-        set(InputIterator first, InputIterator last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type()) : _root(0), _alloc(alloc), _k_comp(comp), _size(0) {
-            _root = _tree.create_node(value_type());
+        set(InputIterator first, InputIterator last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type()) : _tree(node_allocator_type(alloc), comp), _root(0), _alloc(alloc), _k_comp(comp), _size(0) {
+            _root = _tree.create_header();
             insert(first, last);
         }
 
+//		[first, last) must be sorted without duplicates, it is then built in linear time.
+        template <class InputIterator>
+        set(ft::sorted_unique_t, InputIterator first, InputIterator last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type()) : _tree(node_allocator_type(alloc), comp), _root(0), _alloc(alloc), _k_comp(comp), _size(0) {
+            _root = _tree.create_header();
+            insert(ft::sorted_unique, first, last);
+        }
+
         ~set() {
             _tree.clear(&_root->parent);
-            _tree.clear(&_root);
+            _tree.delete_header(_root);
         }
 
-        set(const set& other) : _root(0), _alloc(other._alloc), _k_comp(other._k_comp), _size(0) {
-            _root = _tree.create_node(value_type());
+        set(const set& other) : _tree(other._tree.get_allocator(), other._k_comp), _root(0), _alloc(other._alloc), _k_comp(other._k_comp), _size(0) {
+            _root = _tree.create_header();
             *this = other;
         }
 
         set& operator=(const set& other) {
-            clear();
-            _alloc = other._alloc;
-            _k_comp = other._k_comp;
-            insert(other.begin(), other.end());
+            if (this != &other) {
+                _size = 0;
+                _tree.assign(&_root->parent, other._tree, other._root->parent);
+                _alloc = other._alloc;
+                _k_comp = other._k_comp;
+                _size = other._size;
+            }
             return *this;
         }
 
 	//	************ iterators *************
 
 		iterator begin() {
-            return iterator(_root, _tree.min_node(_root->parent));
+            return iterator(_root, _root->left);
         }
 
         const_iterator begin() const {
-            return const_iterator(_root, _tree.min_node(_root->parent));
+            return const_iterator(_root, _root->left);
         }
 
         iterator end() {
@@ -111,32 +140,115 @@ namespace ft {
         }
 
         ft::pair<iterator, bool> insert(const value_type& val) {
-            bool res = _tree.insert(&_root->parent, _tree.create_node(val));
-            _size += res;
-            node_ptr ptr = _tree.find_node(_root->parent, val);
-            return ft::pair<iterator, bool>(iterator(_root, ptr), res);
+            ft::pair<node_ptr, bool> res = _tree.insert(&_root->parent, val);
+            _size += res.second;
+            return ft::pair<iterator, bool>(iterator(_root, res.first), res.second);
         }
 
-        iterator insert(iterator, const value_type& val) {
-            _size += _tree.insert(&_root->parent, _tree.create_node(val));
-            node_ptr ptr = _tree.find_node(_root->parent, val);
-            return iterator(_root, ptr);
+        iterator insert(iterator position, const value_type& val) {
+            ft::pair<node_ptr, bool> res = _tree.insert(&_root->parent, position.node(), val);
+            _size += res.second;
+            return iterator(_root, res.first);
         }
 
+//		An empty container is built in linear time from a sorted unique forward range, other ranges are inserted with end() as the hint.
         template <class InputIterator>
         void insert(InputIterator first, InputIterator last) {
+            insert_range(first, last, false, typename ft::iterator_traits<InputIterator>::iterator_category());
+        }
+
+        template <class InputIterator>
+        void insert(ft::sorted_unique_t, InputIterator first, InputIterator last) {
+            insert_range(first, last, true, typename ft::iterator_traits<InputIterator>::iterator_category());
+        }
+
+//		Links the node of a handle from extract() without allocating or copying, the tree then shares the arena of the pool it came from.
+//		The value of a node from a set with another allocator is copied instead, and that node destroyed.
+//		When the key is already here the node goes back in the returned handle.
+        insert_return_type insert(node_rvalue nh) {
+            insert_return_type res;
+
+            res.position = end();
+            res.inserted = false;
+            if (nh.empty())
+                return res;
+            if (nh.get_allocator() != _alloc) {
+                ft::pair<iterator, bool> copied = insert(nh.node()->pair);
+                res.position = copied.first;
+                res.inserted = copied.second;
+                nh.give(res.node);
+                if (copied.second)
+                    res.node = node_type();
+                return res;
+            }
+            ft::pair<node_ptr, bool> found = _tree.insert_node(&_root->parent, nh.node());
+            res.position = iterator(_root, found.first);
+            res.inserted = found.second;
+            if (found.second) {
+                _tree.adopt(nh.pin());
+                nh.release();
+                ++_size;
+            }
+            else
+                nh.give(res.node);
+            return res;
+        }
+
+//		Here a handle whose key is already there keeps its node.
+        iterator insert(const_iterator position, node_rvalue nh) {
+            if (nh.empty())
+                return end();
+            if (nh.get_allocator() != _alloc) {
+                size_type before = _size;
+                iterator res = insert(iterator(_root, position.node()), nh.node()->pair);
+                node_type copied;
+                if (_size != before)
+                    nh.give(copied);
+                return res;
+            }
+            ft::pair<node_ptr, bool> found = _tree.insert_node(&_root->parent, position.node(), nh.node());
+            if (found.second) {
+                _tree.adopt(nh.pin());
+                nh.release();
+                ++_size;
+            }
+            return iterator(_root, found.first);
+        }
+    private:
+        template <class InputIterator>
+        void insert_range(InputIterator first, InputIterator last, bool, std::input_iterator_tag) {
             for (; first != last; ++first)
-                insert(*first);
+                insert(end(), *first);
         }
 
+        template <class ForwardIterator>
+        void insert_range(ForwardIterator first, ForwardIterator last, bool sorted, std::forward_iterator_tag) {
+            if (_size == 0 && (sorted || _tree.is_sorted_unique(first, last))) {
+                size_type n = ft::distance(first, last);
+                _tree.build(&_root->parent, first, n);
+                _size = n;
+            }
+            else {
+                for (; first != last; ++first)
+                    insert(end(), *first);
+            }
+        }
+    public:
         void erase(iterator position) {
-            bool res = _tree.erase(&_root->parent, *position);
+            _tree.erase_node(&_root->parent, position.node());
+            --_size;
+        }
+
+        size_type erase(const key_type& k) {
+            bool res = (bool)_tree.erase(&_root->parent, k);
 
             if (res)
                 --_size;
+            return res;
         }
 
-        size_type erase(const key_type& k) {
+        template <class K>
+        typename enable_if_transparent<K, size_type>::type erase(const K& k) {
             bool res = (bool)_tree.erase(&_root->parent, k);
 
             if (res)
@@ -144,14 +256,18 @@ namespace ft {
             return res;
         }
 
+//		Unlinks the nodes one after the other without searching, erasing everything is a clear().
         void erase(iterator first, iterator last) {
-            while(first != last)
-                erase(first++);
+            if (first == begin() && last == end())
+                clear();
+            else
+                _size -= _tree.erase_range(&_root->parent, first.node(), last.node());
         }
 
         void swap(set& x) {
 			node_ptr root = _root;
 			allocator_type alloc = _alloc;
+			_tree.swap(x._tree);
 			key_compare key = _k_comp;
 			size_type size = _size;
 			_root = x._root;
@@ -170,6 +286,107 @@ namespace ft {
             _size = 0;
         }
 
+//		Set algebra with a set ordered the same way: O(m log(n / m + 1)) for the m elements of other, on top of copying them.
+//		On equal keys the elements already here are the ones kept.
+        void set_union(const set& other) {
+            _size += other._size - _tree.unite(&_root->parent, _tree.copy(other._root->parent));
+        }
+
+        void set_intersection(const set& other) {
+            _size = _tree.intersect(&_root->parent, _tree.copy(other._root->parent));
+        }
+
+        void set_difference(const set& other) {
+            _size -= _tree.subtract(&_root->parent, _tree.copy(other._root->parent));
+        }
+
+//		Moves the elements not less than k into greater, dropping what it held, in O(log n).
+//		Without FT_ORDER_STATISTICS the elements on the smaller side of k are counted on top of that.
+//		Nodes only move between containers with equal allocators, the elements are copied across otherwise.
+        void split_at(const key_type& k, set& greater) {
+            if (&greater == this)
+                return;
+            greater.clear();
+            if (greater._alloc != _alloc) {
+                iterator first = lower_bound(k);
+                greater.insert(ft::sorted_unique, first, end());
+                erase(first, end());
+                return;
+            }
+            size_type below = _tree.count_below(_root->parent, k, _size);
+            greater._tree.share_pool(_tree);
+            greater._root->parent = _tree.split_off(&_root->parent, k);
+            greater._tree.reset_extremes(greater._root->parent);
+            greater._size = _size - below;
+            _size = below;
+        }
+
+//		Moves every element of other here and leaves it empty: O(log n) when its keys all come after the ones here, a union otherwise.
+//		The elements of an other with a different allocator are copied here instead.
+        void join(set& other) {
+            if (&other == this)
+                return;
+            if (other._alloc != _alloc) {
+                insert(other.begin(), other.end());
+                other.clear();
+                return;
+            }
+            _tree.share_pool(other._tree);
+            node_ptr source = other._root->parent;
+            size_type count = other._size;
+            other._root->parent = 0;
+            other._tree.reset_extremes(0);
+            other._size = 0;
+            _size += count - _tree.join(&_root->parent, source);
+        }
+
+//		Unlinks an element and hands it over with its value, to be inserted here again or into another set.
+        node_type extract(const_iterator position) {
+            typename tree_type::pin_type pin = _tree.pin();
+
+            _tree.unlink_node(&_root->parent, position.node());
+            --_size;
+            return node_type(position.node(), pin, _tree.get_allocator());
+        }
+
+        node_type extract(const key_type& k) {
+            node_ptr some = _tree.find_node(_root->parent, k);
+
+            if (!some)
+                return node_type();
+            return extract(const_iterator(_root, some));
+        }
+
+//		Relinks the nodes of source whose keys are not here yet, without allocating or copying: the others stay in source.
+//		With another allocator the values are copied and erased from source.
+        void merge(set& source) {
+            node_ptr parent;
+            bool left;
+
+            if (&source == this)
+                return;
+            if (source._alloc != _alloc) {
+                for (iterator it = source.begin(); it != source.end(); ) {
+                    if (insert(*it).second)
+                        source.erase(it++);
+                    else
+                        ++it;
+                }
+                return;
+            }
+            _tree.share_pool(source._tree);
+            for (node_ptr some = source._root->left; some; ) {
+                node_ptr next = source._tree.next_node(some);
+                if (!_tree.insert_position(_root->parent, some->pair, parent, left)) {
+                    source._tree.unlink_node(&source._root->parent, some);
+                    _tree.link_node(&_root->parent, parent, left, some);
+                    --source._size;
+                    ++_size;
+                }
+                some = next;
+            }
+        }
+
         key_compare key_comp() const {
             return _k_comp;
         }
@@ -203,21 +420,11 @@ namespace ft {
         }
 
         iterator upper_bound(const key_type& k) {
-            node_ptr tmp = _tree.lower(_root->parent, k);
-            iterator res(_root, tmp);
-
-            if (tmp && tmp->pair == k)
-                ++res;
-            return iterator(res);
+            return iterator(_root, _tree.upper(_root->parent, k));
         }
 
         const_iterator upper_bound(const key_type& k) const {
-            node_ptr tmp = _tree.lower(_root->parent, k);
-            iterator res(_root, tmp);
-
-            if (tmp && tmp->pair == k)
-                ++res;
-            return const_iterator(res);
+            return const_iterator(_root, _tree.upper(_root->parent, k));
         }
 
         ft::pair<iterator, iterator> equal_range(const key_type& k) {
@@ -228,6 +435,81 @@ namespace ft {
             return ft::make_pair(lower_bound(k), upper_bound(k));
         }
 
+#ifdef FT_ORDER_STATISTICS
+//		Order statistics from the subtree sizes, all O(log n).
+//		nth(k) is the element at index k, end() past the last one.
+        iterator nth(size_type k) {
+            return iterator(_root, ft::select_node(_root->parent, k));
+        }
+
+        const_iterator nth(size_type k) const {
+            return const_iterator(_root, ft::select_node(_root->parent, k));
+        }
+
+//		Number of keys less than k, i.e. the index of lower_bound(k).
+        size_type rank(const key_type& k) const {
+            return _tree.rank(_root->parent, k);
+        }
+
+//		Number of keys in [lo, hi).
+        size_type range_count(const key_type& lo, const key_type& hi) const {
+            size_type low = rank(lo);
+            size_type high = rank(hi);
+
+            return high > low ? high - low : 0;
+        }
+#endif
+
+//		Heterogeneous lookup, enabled when Compare declares is_transparent like ft::less<void>.
+        template <class K>
+        typename enable_if_transparent<K, iterator>::type find(const K& k) {
+            node_ptr ptr = _tree.find_node(_root->parent, k);
+            return iterator(_root, ptr);
+        }
+
+        template <class K>
+        typename enable_if_transparent<K, const_iterator>::type find(const K& k) const {
+            node_ptr ptr = _tree.find_node(_root->parent, k);
+            return const_iterator(_root, ptr);
+        }
+
+        template <class K>
+        typename enable_if_transparent<K, size_type>::type count(const K& k) const {
+            if (_tree.find_node(_root->parent, k))
+                return 1;
+            return 0;
+        }
+
+        template <class K>
+        typename enable_if_transparent<K, iterator>::type lower_bound(const K& k) {
+            return iterator(_root, _tree.lower(_root->parent, k));
+        }
+
+        template <class K>
+        typename enable_if_transparent<K, const_iterator>::type lower_bound(const K& k) const {
+            return const_iterator(_root, _tree.lower(_root->parent, k));
+        }
+
+        template <class K>
+        typename enable_if_transparent<K, iterator>::type upper_bound(const K& k) {
+            return iterator(_root, _tree.upper(_root->parent, k));
+        }
+
+        template <class K>
+        typename enable_if_transparent<K, const_iterator>::type upper_bound(const K& k) const {
+            return const_iterator(_root, _tree.upper(_root->parent, k));
+        }
+
+        template <class K>
+        typename enable_if_transparent<K, ft::pair<iterator, iterator> >::type equal_range(const K& k) {
+            return ft::make_pair(lower_bound(k), upper_bound(k));
+        }
+
+        template <class K>
+        typename enable_if_transparent<K, ft::pair<const_iterator, const_iterator> >::type equal_range(const K& k) const {
+            return ft::make_pair(lower_bound(k), upper_bound(k));
+        }
+
         allocator_type get_allocator() const {
             return _alloc;
         }
@@ -0,0 +1,232 @@
+#pragma once
+
+#include "vector.hpp"
+
+namespace ft {
+//	Hands out the inline buffer of a small_vector for requests of up to N elements and forwards anything else to Alloc.
+    template <class T, size_t N, class Alloc = std::allocator<T> >
+    class small_vector_allocator {
+    public:
+        typedef T										value_type;
+        typedef typename Alloc::pointer					pointer;
+        typedef typename Alloc::const_pointer			const_pointer;
+        typedef typename Alloc::reference				reference;
+        typedef typename Alloc::const_reference			const_reference;
+        typedef typename Alloc::size_type				size_type;
+        typedef typename Alloc::difference_type			difference_type;
+
+//		A rebound allocator has no inline buffer of its own and only keeps the upstream.
+        template <class U>
+        struct rebind {
+            typedef small_vector_allocator<U, N, typename Alloc::template rebind<U>::other> other;
+        };
+    private:
+        pointer	_buffer;
+        bool	_used;
+        Alloc	_upstream;
+
+        template <class U, size_t M, class A>
+        friend class small_vector_allocator;
+    public:
+        small_vector_allocator(pointer buffer = 0, const Alloc& upstream = Alloc()) : _buffer(buffer), _used(false), _upstream(upstream) {}
+
+        small_vector_allocator(const small_vector_allocator& other) : _buffer(other._buffer), _used(other._used), _upstream(other._upstream) {}
+
+        template <class U, class A>
+        small_vector_allocator(const small_vector_allocator<U, N, A>& other) : _buffer(0), _used(false), _upstream(other._upstream) {}
+
+        small_vector_allocator& operator=(const small_vector_allocator& other) {
+            _buffer = other._buffer;
+            _used = other._used;
+            _upstream = other._upstream;
+            return *this;
+        }
+
+        pointer allocate(size_type n, const void* = 0) {
+            if (_buffer && !_used && n <= N) {
+                _used = true;
+                return _buffer;
+            }
+            return _upstream.allocate(n);
+        }
+
+        void deallocate(pointer p, size_type n) {
+            if (p == _buffer)
+                _used = false;
+            else
+                _upstream.deallocate(p, n);
+        }
+
+        size_type max_size() const {
+            return _upstream.max_size();
+        }
+
+        void construct(pointer p, const_reference val) {
+            _upstream.construct(p, val);
+        }
+
+#if __cplusplus >= 201103L
+        template <class U, class... Args>
+        void construct(U* p, Args&&... args) {
+            ::new(static_cast<void*>(p)) U(std::forward<Args>(args)...);
+        }
+#endif
+
+        void destroy(pointer p) {
+            _upstream.destroy(p);
+        }
+
+        pointer address(reference x) const {
+            return _upstream.address(x);
+        }
+
+        const_pointer address(const_reference x) const {
+            return _upstream.address(x);
+        }
+
+        Alloc upstream() const {
+            return _upstream;
+        }
+
+        bool owns(const_pointer p) const {
+            return p == _buffer;
+        }
+
+        friend bool operator==(const small_vector_allocator& x, const small_vector_allocator& y) {
+            return x._buffer == y._buffer && x._upstream == y._upstream;
+        }
+
+        friend bool operator!=(const small_vector_allocator& x, const small_vector_allocator& y) {
+            return !(x == y);
+        }
+    };
+
+//	A vector that keeps up to N elements in an inline buffer and only asks the allocator for memory beyond that.
+//	It is an ft::vector, so it shares its iterators, member functions and comparison operators.
+    template <class T, size_t N, class Alloc = std::allocator<T> >
+    class small_vector : public ft::vector<T, ft::small_vector_allocator<T, N, Alloc> > {
+    private:
+        typedef ft::vector<T, ft::small_vector_allocator<T, N, Alloc> >	base;
+//		An empty inline buffer cannot be declared.
+        typedef char inline_capacity_must_be_positive[N > 0 ? 1 : -1];
+    public:
+        typedef typename base::value_type								value_type;
+        typedef typename base::allocator_type							allocator_type;
+        typedef typename base::size_type								size_type;
+        typedef typename base::pointer									pointer;
+        typedef typename base::iterator									iterator;
+        typedef typename base::const_iterator							const_iterator;
+        static const size_type											inline_capacity = N;
+    private:
+//		Raw inline storage, the union only forces an alignment suitable for any fundamental type.
+        union storage {
+            char		bytes[sizeof(T) * N];
+            long double	align_float;
+            long		align_integer;
+            void*		align_pointer;
+        };
+        storage			_storage;
+
+        pointer buffer() {
+            return reinterpret_cast<pointer>(_storage.bytes);
+        }
+
+//		Points the vector at the inline buffer, an empty small_vector starts with a capacity of N.
+        void use_inline() {
+            this->_alloc = allocator_type(buffer(), this->_alloc.upstream());
+            this->_pointer = this->_alloc.allocate(N);
+            this->_size = 0;
+            this->_capacity = N;
+        }
+    public:
+        explicit small_vector(const Alloc& alloc = Alloc()) : base(allocator_type(0, alloc)) {
+            use_inline();
+        }
+
+        explicit small_vector(size_type n, const value_type& val = value_type(), const Alloc& alloc = Alloc()) : base(allocator_type(0, alloc)) {
+            use_inline();
+            this->insert(this->end(), n, val);
+        }
+
+        template <class InputIterator>
+        small_vector(InputIterator first, InputIterator last, const Alloc& alloc = Alloc(), typename ft::enable_if<!ft::is_integral<InputIterator>::value>::type* = 0) : base(allocator_type(0, alloc)) {
+            use_inline();
+            this->insert(this->end(), first, last);
+        }
+
+        small_vector(const small_vector& x) : base(allocator_type(0, x._alloc.upstream())) {
+            use_inline();
+            this->insert(this->end(), x.begin(), x.end());
+        }
+
+        small_vector& operator=(const small_vector& x) {
+            base::operator=(x);
+            return *this;
+        }
+
+#if __cplusplus >= 201103L
+        small_vector(small_vector&& x) : base(allocator_type(0, x._alloc.upstream())) {
+            use_inline();
+            steal(x);
+        }
+
+        small_vector& operator=(small_vector&& x) {
+            if (this != &x) {
+                this->clear();
+                this->_alloc.deallocate(this->_pointer, this->_capacity);
+                this->_pointer = this->_alloc.allocate(N);
+                this->_capacity = N;
+                steal(x);
+            }
+            return *this;
+        }
+#endif
+
+//		Heap buffers are exchanged in O(1) along with the upstream allocators that have to free them, inline elements have to be copied across.
+        void swap(small_vector& x) {
+            if (this->_alloc.owns(this->_pointer) || x._alloc.owns(x._pointer)) {
+                small_vector tmp(*this);
+
+                *this = x;
+                x = tmp;
+                return ;
+            }
+            Alloc upstream = this->_alloc.upstream();
+            this->_alloc = allocator_type(buffer(), x._alloc.upstream());
+            x._alloc = allocator_type(x.buffer(), upstream);
+            std::swap(this->_pointer, x._pointer);
+            std::swap(this->_size, x._size);
+            std::swap(this->_capacity, x._capacity);
+        }
+
+//		True while the elements still live in the inline buffer.
+        bool is_inline() const {
+            return this->_alloc.owns(this->_pointer);
+        }
+
+    private:
+#if __cplusplus >= 201103L
+//		Takes over a heap buffer as is and moves inline elements one by one, x is left empty and inline.
+        void steal(small_vector& x) {
+            if (x.is_inline()) {
+                for (size_type i = 0; i < x._size; ++i)
+                    this->emplace_back(std::move(x._pointer[i]));
+                x.clear();
+                return ;
+            }
+            this->_alloc.deallocate(this->_pointer, this->_capacity);
+            this->_pointer = x._pointer;
+            this->_size = x._size;
+            this->_capacity = x._capacity;
+            x._pointer = x._alloc.allocate(N);
+            x._size = 0;
+            x._capacity = N;
+        }
+#endif
+    };
+
+    template <class T, size_t N, class Alloc>
+    void swap(small_vector<T, N, Alloc>& lhs, small_vector<T, N, Alloc>& rhs) {
+        lhs.swap(rhs);
+    }
+}
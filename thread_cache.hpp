@@ -0,0 +1,270 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <limits>
+#include <pthread.h>
+#include "utils.hpp"
+#include "pool.hpp"
+
+#if __cplusplus >= 201103L
+# define FT_THREAD_LOCAL thread_local
+#else
+# define FT_THREAD_LOCAL __thread
+#endif
+
+namespace ft {
+//	Per-thread caches of free blocks of one size, backed by a depot shared by all threads.
+//	Each thread allocates from and frees into its own magazine without any synchronisation, whichever thread the block came from.
+//	A magazine that grows past two batches hands one batch back to the depot under a spinlock, an empty one takes a batch from the depot or carves a new slab.
+//	Slabs are never returned to the system, a thread that exits gives its magazine back to the depot.
+    template <size_t Size>
+    class thread_cache {
+    private:
+        struct free_block {
+            free_block*	next;
+        };
+
+//		Kept in the first block of a batch sitting in the depot.
+        struct batch {
+            batch*		next;
+            free_block*	blocks;
+            size_t		count;
+        };
+
+        struct magazine {
+            free_block*	head;
+            size_t		count;
+        };
+
+        struct depot {
+            batch*			top;
+            volatile int	lock;
+        };
+
+        static const size_t	align = sizeof(void*) * 2;
+        static const size_t	batch_size = 64;
+    public:
+        static const size_t	block_size = ((Size < sizeof(batch) ? sizeof(batch) : Size) + align - 1) / align * align;
+    private:
+        static magazine*& local() {
+            static FT_THREAD_LOCAL magazine* current = 0;
+            return current;
+        }
+
+        static depot& shared() {
+            static depot instance = { 0, 0 };
+            return instance;
+        }
+
+        static pthread_key_t& key() {
+            static pthread_key_t instance;
+            return instance;
+        }
+
+        static void create_key() {
+            pthread_key_create(&key(), &detach);
+        }
+
+//		Waits on a relaxed atomic load, which does not take the cache line from the holder, before it tries the exchange again.
+        static void lock(depot& d) {
+            while (__sync_lock_test_and_set(&d.lock, 1))
+                while (__atomic_load_n(&d.lock, __ATOMIC_RELAXED))
+                    ft::spin_pause();
+        }
+
+        static void unlock(depot& d) {
+            __sync_lock_release(&d.lock);
+        }
+
+        static magazine* attach() {
+            static pthread_once_t once = PTHREAD_ONCE_INIT;
+            magazine* fresh = new magazine;
+
+            fresh->head = 0;
+            fresh->count = 0;
+            pthread_once(&once, &create_key);
+            pthread_setspecific(key(), fresh);
+            local() = fresh;
+            return fresh;
+        }
+
+//		Runs when a thread exits: everything it still caches goes to the depot.
+        static void detach(void* p) {
+            magazine* cache = static_cast<magazine*>(p);
+
+            while (cache->count)
+                flush(cache, cache->count < batch_size ? cache->count : batch_size);
+            if (local() == cache)
+                local() = 0;
+            delete cache;
+        }
+
+//		Moves n blocks from the magazine to the depot as one batch.
+        static void flush(magazine* cache, size_t n) {
+            free_block* first = cache->head;
+            free_block* last = first;
+
+            for (size_t i = 1; i < n; ++i)
+                last = last->next;
+            cache->head = last->next;
+            cache->count -= n;
+            last->next = 0;
+            free_block* rest = first->next;
+            batch* out = ::new(static_cast<void*>(first)) batch;
+            out->blocks = rest;
+            out->count = n;
+            depot& d = shared();
+            lock(d);
+            out->next = d.top;
+            d.top = out;
+            unlock(d);
+        }
+
+//		Fills an empty magazine from the depot, or from a new slab when the depot is empty too.
+        static void refill(magazine* cache) {
+            depot& d = shared();
+            lock(d);
+            batch* in = d.top;
+            if (in)
+                d.top = in->next;
+            unlock(d);
+            if (in) {
+                size_t count = in->count;
+                free_block* blocks = in->blocks;
+                free_block* first = reinterpret_cast<free_block*>(in);
+                first->next = blocks;
+                cache->head = first;
+                cache->count = count;
+                return;
+            }
+            char* slab = static_cast<char*>(::operator new(block_size * batch_size));
+            for (size_t i = batch_size; i > 0; --i) {
+                free_block* block = reinterpret_cast<free_block*>(slab + (i - 1) * block_size);
+                block->next = cache->head;
+                cache->head = block;
+            }
+            cache->count = batch_size;
+        }
+
+    public:
+        static void* allocate() {
+            magazine* cache = local();
+
+            if (!cache)
+                cache = attach();
+            if (!cache->head)
+                refill(cache);
+            free_block* block = cache->head;
+            cache->head = block->next;
+            --cache->count;
+            return block;
+        }
+
+        static void deallocate(void* p) {
+            magazine* cache = local();
+
+            if (!cache)
+                cache = attach();
+            free_block* block = static_cast<free_block*>(p);
+            block->next = cache->head;
+            cache->head = block;
+            if (++cache->count >= 2 * batch_size)
+                flush(cache, batch_size);
+        }
+    };
+
+//	Allocator that serves single objects from the calling thread's ft::thread_cache, meant for tree nodes shared between threads.
+//	Arrays and over-aligned types go straight to operator new and delete.
+    template <class T>
+    class thread_cache_allocator {
+    public:
+        typedef T				value_type;
+        typedef T*				pointer;
+        typedef const T*		const_pointer;
+        typedef T&				reference;
+        typedef const T&		const_reference;
+        typedef size_t			size_type;
+        typedef std::ptrdiff_t	difference_type;
+
+        template <class U>
+        struct rebind {
+            typedef thread_cache_allocator<U> other;
+        };
+    private:
+        typedef ft::thread_cache<sizeof(T)>	cache_type;
+
+        static bool cached(size_type n) {
+            return n == 1 && ft::alignment_of<T>::value <= sizeof(void*) * 2;
+        }
+    public:
+        thread_cache_allocator() {}
+
+        thread_cache_allocator(const thread_cache_allocator&) {}
+
+        template <class U>
+        thread_cache_allocator(const thread_cache_allocator<U>&) {}
+
+        ~thread_cache_allocator() {}
+
+        thread_cache_allocator& operator=(const thread_cache_allocator&) {
+            return *this;
+        }
+
+        pointer allocate(size_type n, const void* = 0) {
+            if (n > max_size())
+                throw std::bad_alloc();
+            if (cached(n))
+                return static_cast<pointer>(cache_type::allocate());
+            return static_cast<pointer>(::operator new(n * sizeof(T)));
+        }
+
+        void deallocate(pointer p, size_type n) {
+            if (cached(n))
+                cache_type::deallocate(p);
+            else
+                ::operator delete(p);
+        }
+
+        size_type max_size() const {
+            return std::numeric_limits<size_type>::max() / sizeof(T);
+        }
+
+        void construct(pointer p, const_reference val) {
+            ::new(static_cast<void*>(p)) T(val);
+        }
+
+#if __cplusplus >= 201103L
+        template <class U, class... Args>
+        void construct(U* p, Args&&... args) {
+            ::new(static_cast<void*>(p)) U(std::forward<Args>(args)...);
+        }
+#endif
+
+        void destroy(pointer p) {
+            p->~T();
+        }
+
+        pointer address(reference x) const {
+            return &x;
+        }
+
+        const_pointer address(const_reference x) const {
+            return &x;
+        }
+
+        template <class U>
+        bool operator==(const thread_cache_allocator<U>&) const {
+            return true;
+        }
+
+        template <class U>
+        bool operator!=(const thread_cache_allocator<U>&) const {
+            return false;
+        }
+    };
+
+//	The per-thread magazines already recycle nodes, a tree-local pool would only keep them from moving between threads.
+    template <class T>
+    struct use_node_pool<thread_cache_allocator<T> > : public ft::false_type {};
+}
@@ -2,36 +2,152 @@
 
 #include "traits.hpp"
 #include "pair.hpp"
+#include "pool.hpp"
 
 namespace ft {
+//	Subtree sizes kept with FT_ORDER_STATISTICS, the setters do nothing without it.
+    template <class NodePtr>
+    size_t subtree_count(NodePtr some) {
+#ifdef FT_ORDER_STATISTICS
+        return some ? some->count : 0;
+#else
+        (void)some;
+        return 0;
+#endif
+    }
+
+    template <class NodePtr>
+    void set_subtree_count(NodePtr some, size_t count) {
+#ifdef FT_ORDER_STATISTICS
+        some->count = count;
+#else
+        (void)some;
+        (void)count;
+#endif
+    }
+
+//	Adds one to (or takes one from) every subtree size from some up to the root.
+    template <class NodePtr>
+    void adjust_subtree_counts(NodePtr some, bool grow) {
+#ifdef FT_ORDER_STATISTICS
+        for (; some; some = some->get_parent()) {
+            if (grow)
+                ++some->count;
+            else
+                --some->count;
+        }
+#else
+        (void)some;
+        (void)grow;
+#endif
+    }
+
+#ifdef FT_ORDER_STATISTICS
+//	Node of in-order position k under root, 0 when k is out of range.
+    template <class NodePtr>
+    NodePtr select_node(NodePtr root, size_t k) {
+        while (root) {
+            size_t left = subtree_count(root->left);
+            if (k < left)
+                root = root->left;
+            else if (k == left)
+                return root;
+            else {
+                k -= left + 1;
+                root = root->right;
+            }
+        }
+        return root;
+    }
+
+//	In-order position of a node, counted on the way up to the root.
+    template <class NodePtr>
+    size_t node_position(NodePtr some) {
+        size_t res = subtree_count(some->left);
+
+        for (NodePtr parent = some->get_parent(); parent; some = parent, parent = parent->get_parent()) {
+            if (parent->right == some)
+                res += subtree_count(parent->left) + 1;
+        }
+        return res;
+    }
+#endif
+
     template <class Value, class Compare, class Alloc = std::allocator <Value> >
     class Tree {
     public:
         typedef Alloc 								allocator_type;
         typedef typename allocator_type::pointer	node_ptr;
+        typedef ft::node_pool<typename allocator_type::value_type, allocator_type>	pool_type;
+        typedef typename pool_type::pin_type										pin_type;
     private:
         allocator_type								_alloc;
         Compare										_compare;
+        pool_type									_pool;
+        node_ptr									_header;
     public:
+        explicit Tree(const allocator_type& alloc = allocator_type(), const Compare& compare = Compare()) : _alloc(alloc), _compare(compare), _pool(alloc), _header(0) {}
+
+        allocator_type get_allocator() const {
+            return _alloc;
+        }
+
+//		Nodes have to be released through the allocator that made them, so it travels with the nodes.
+        void swap(Tree& other) {
+            allocator_type alloc = _alloc;
+            Compare compare = _compare;
+            _alloc = other._alloc;
+            _compare = other._compare;
+            other._alloc = alloc;
+            other._compare = compare;
+            _pool.swap(other._pool);
+            node_ptr header = _header;
+            _header = other._header;
+            other._header = header;
+        }
+
         node_ptr create_node(Value toAdd) {
-            node_ptr new_node = _alloc.allocate(1);
+            node_ptr new_node = _pool.allocate();
 
-            _alloc.construct(new_node, toAdd);
+            try {
+                _alloc.construct(new_node, toAdd);
+            } catch (...) {
+                _pool.deallocate(new_node);
+                throw;
+            }
             return new_node;
         }
 
         void delete_node(node_ptr some) {
             if (some) {
                 _alloc.destroy(some);
-                _alloc.deallocate(some, 1);
+                _pool.deallocate(some);
             }
         }
 
-        void swap_color(node_ptr some) {
-            bool color = some->isBlack;
-            some->isBlack = some->right->isBlack;
-            some->right->isBlack = color;
-            some->left->isBlack = color;
+//		The header outlives clear(), so it is allocated outside the pool.
+//		Its parent is the root, its left and right cache the leftmost and rightmost nodes for begin() and --end().
+        node_ptr create_header() {
+            node_ptr header = _alloc.allocate(1);
+
+            try {
+                _alloc.construct(header, Value());
+            } catch (...) {
+                _alloc.deallocate(header, 1);
+                throw;
+            }
+            _header = header;
+            return header;
+        }
+
+        void delete_header(node_ptr header) {
+            _alloc.destroy(header);
+            _alloc.deallocate(header, 1);
+        }
+
+        void reset_extremes(node_ptr root) {
+            _header->left = min_node(root);
+            _header->right = max_node(root);
         }
 
         node_ptr min_node(node_ptr some) const {
@@ -50,341 +166,950 @@ namespace ft {
             return some;
         }
 
-        node_ptr find_node(node_ptr tmp, Value key) const  {
-            if (tmp) {
-                if (_compare(tmp->pair, key))
-                    return find_node(tmp->right, key);
-                else if (_compare(key, tmp->pair)){
-                    return find_node(tmp->left, key);
+//		Searches take any key the comparator accepts next to a Value, a map compares a bare key against its pairs.
+        template <class K>
+        node_ptr find_node(node_ptr tmp, const K& key) const  {
+            node_ptr res = lower(tmp, key);
+
+            if (res && _compare(key, res->pair))
+                return 0;
+            return res;
+        }
+
+//		First node not less than key: one comparison per level, equality is left to the caller.
+        template <class K>
+        node_ptr lower(node_ptr root, const K& key) const {
+            node_ptr res = 0;
+
+            while (root) {
+                if (!_compare(root->pair, key)) {
+                    res = root;
+                    root = root->left;
                 }
+                else
+                    root = root->right;
             }
-            return tmp;
+            return res;
         }
 
-        node_ptr lower(node_ptr root, Value key) const {
-            node_ptr tmp = 0;
+//		First node greater than key.
+        template <class K>
+        node_ptr upper(node_ptr root, const K& key) const {
+            node_ptr res = 0;
 
             while (root) {
-                if (_compare(root->pair, key))
-                    root = root->right;
-                else
-                {
-                    if (root->left) {
-                        tmp = lower(root->left, key);
-                        if (tmp)
-                            root = tmp;
-                        break;
-                    }
-                    else
-                        break;
+                if (_compare(key, root->pair)) {
+                    res = root;
+                    root = root->left;
                 }
+                else
+                    root = root->right;
             }
-            return root;
+            return res;
         }
 
+//		Destroys the whole tree and hands the pool's slabs back in one go.
         void clear(node_ptr* root) {
-			if (*root == 0)
-				return ;
-            if (*root)
-            {
-                if ((*root)->left)
-                    clear(&((*root)->left));
-                if ((*root)->right)
-                    clear(&((*root)->right));
-                delete_node((*root));
-            }
-            *root = 0;
+            destroy(root);
+            _pool.release();
+            reset_extremes(0);
         }
 
         size_t max_size() const {
             return _alloc.max_size();
         }
 
-        void insert_balance(node_ptr* root, node_ptr some) {
-            node_ptr parent;
-            node_ptr grand;
-            node_ptr tmp;
+//		Teardown in O(n) time and O(1) space: a left child is rotated up until the node has none, then the node goes and its right subtree follows.
+        void destroy(node_ptr* root) {
+            node_ptr some = *root;
 
             while (some) {
-                parent = some->parent;
-                grand = 0;
-                tmp = parent;
-                if (parent) {
-                    grand = parent->parent;
-                    if (some->isBlack == false) {
-                        if (parent->isBlack == true)
-                            some = parent;
-                        else if (grand) {
-                            if (grand->left && grand->left->isBlack == false && grand->right && grand->right->isBlack == false) {
-                                swap_color(grand);
-                                some = grand;
-                            }
-                            else if (grand->right == parent) {
-                                if (parent->left == some) {
-                                    rotate_right(parent, root);
-                                    parent = some;
-                                }
-                                if (parent->right == some)
-                                    rotate_left(grand, root);
-                                some = parent->parent;
-                            }
-                            else {
-                                if (parent->right == some) {
-                                    rotate_left(parent, root);
-                                    parent = some;
-                                }
-                                if (parent->left == some)
-                                    rotate_right(grand, root);
-                                some = parent->parent;
-                            }
-                        }
-                    }
-                    else
-                        some = parent;
+                node_ptr next;
+                if (some->left) {
+                    next = some->left;
+                    some->left = next->right;
+                    next->right = some;
                 }
                 else {
-                    some->isBlack = true;
-                    some = some->parent;
+                    next = some->right;
+                    delete_node(some);
                 }
+                some = next;
             }
+            *root = 0;
         }
 
-        bool insert(node_ptr* root, node_ptr new_node) {
-            if (*root == 0) {
-                *root = new_node;
-                new_node->isBlack = true;
-            }
-            else {
-                node_ptr tmp = *root;
-                while (tmp) {
-                    if (!_compare(tmp->pair, new_node->pair) && !_compare(new_node->pair, tmp->pair)) {
-                        if (tmp != new_node)
-                            delete_node(new_node);
-                        return false;
-                    }
-                    else if (_compare(new_node->pair, tmp->pair)) {
-                        if (tmp->left)
-                            tmp = tmp->left;
-                        else {
-                            tmp->left = new_node;
-                            new_node->parent = tmp;
-                            break;
+//		Restores the red-black rules after linking the red node some: recolours while the uncle is red, otherwise rotates once or twice under the grandparent.
+//		Returns whether the root had to be blackened, i.e. the black height grew.
+        bool insert_balance(node_ptr* root, node_ptr some) {
+            node_ptr parent;
+            node_ptr grand;
+            node_ptr uncle;
+
+            while (some->get_parent() && some->get_parent()->is_black() == false) {
+                parent = some->get_parent();
+                grand = parent->get_parent();
+                uncle = (grand->left == parent) ? grand->right : grand->left;
+                if (uncle && uncle->is_black() == false) {
+                    parent->set_black(true);
+                    uncle->set_black(true);
+                    grand->set_black(false);
+                    some = grand;
+                }
+                else {
+                    if (grand->left == parent) {
+                        if (parent->right == some) {
+                            rotate_left(parent, root);
+                            parent = some;
                         }
+                        rotate_right(grand, root);
                     }
                     else {
-                        if (tmp->right)
-                            tmp = tmp->right;
-                        else {
-                            tmp->right = new_node;
-                            new_node->parent = tmp;
-                            break;
+                        if (parent->left == some) {
+                            rotate_right(parent, root);
+                            parent = some;
                         }
+                        rotate_left(grand, root);
                     }
+                    parent->set_black(true);
+                    grand->set_black(false);
+                    break;
                 }
             }
-            insert_balance(root, new_node);
-            return true;
+            bool grew = !(*root)->is_black();
+            (*root)->set_black(true);
+            return grew;
         }
 
-        void swap_p(node_ptr remove, node_ptr replace) {
-            if (remove->parent) {
-                if (remove->parent->left == remove)
-                    remove->parent->left = replace;
-                else
-                    remove->parent->right = replace;
-            }
-            replace->parent = remove->parent;
-            if (remove->left) {
-                remove->left->parent = replace;
-            }
-            replace->left = remove->left;
-            if (remove->right) {
-                remove->right->parent = replace;
+//		Descends once with one comparison per level: returns the node holding an equal value, or links a node made from val where the descent ended.
+        ft::pair<node_ptr, bool> insert(node_ptr* root, const Value& val) {
+            node_ptr parent;
+            bool left;
+            node_ptr equal = insert_position(*root, val, parent, left);
+
+            if (equal)
+                return ft::pair<node_ptr, bool>(equal, false);
+            return ft::pair<node_ptr, bool>(link(root, parent, left, val), true);
+        }
+
+//		Same for a node that is in no tree, which is linked as it is or left alone when its value is already there.
+        ft::pair<node_ptr, bool> insert_node(node_ptr* root, node_ptr some) {
+            node_ptr parent;
+            bool left;
+            node_ptr equal = insert_position(*root, some->pair, parent, left);
+
+            if (equal)
+                return ft::pair<node_ptr, bool>(equal, false);
+            link_node(root, parent, left, some);
+            return ft::pair<node_ptr, bool>(some, true);
+        }
+
+//		Returns the node equal to val, or 0 with the parent and side a node for val would be linked at.
+//		Only the greatest node not greater than val can be equal to it: the last node left to the right, or the predecessor of the last one left to the left.
+//		val may also be a bare key the comparator takes, so that a caller can search before it builds a value.
+        template <class K>
+        node_ptr insert_position(node_ptr root, const K& val, node_ptr& parent, bool& left) const {
+            parent = 0;
+            left = true;
+            while (root) {
+                parent = root;
+                left = _compare(val, root->pair);
+                root = left ? root->left : root->right;
             }
-            replace->right = remove->right;
-            replace->isBlack = remove->isBlack;
+            node_ptr before = parent;
+            if (parent && left)
+                before = prev_node(parent);
+            if (before && !_compare(before->pair, val))
+                return before;
+            return 0;
         }
 
-        bool erase(node_ptr* root, Value key) {
-            node_ptr remove = find_node(*root, key);
-			
-            if (remove) {
-                node_ptr replace = 0;
-                if (remove->left)
-                    replace = erase_left(remove, root);
-                else if (remove->right)
-                    replace = erase_right(remove, root);
-                else
-                    erase_not_child(remove, root);
-                if (replace)
-                    swap_p(remove, replace);
-                if (remove == *root) {
-                    if (replace)
-                        *root = replace;
-                    else
-                        *root = 0;
+//		Inserts next to hint (0 means end) when val belongs right before or right after it, otherwise descends from the root.
+        ft::pair<node_ptr, bool> insert(node_ptr* root, node_ptr hint, const Value& val) {
+            node_ptr parent;
+            bool left;
+            node_ptr equal = hint_position(*root, hint, val, parent, left);
+
+            if (equal)
+                return ft::pair<node_ptr, bool>(equal, false);
+            return ft::pair<node_ptr, bool>(link(root, parent, left, val), true);
+        }
+
+        ft::pair<node_ptr, bool> insert_node(node_ptr* root, node_ptr hint, node_ptr some) {
+            node_ptr parent;
+            bool left;
+            node_ptr equal = hint_position(*root, hint, some->pair, parent, left);
+
+            if (equal)
+                return ft::pair<node_ptr, bool>(equal, false);
+            link_node(root, parent, left, some);
+            return ft::pair<node_ptr, bool>(some, true);
+        }
+
+        node_ptr hint_position(node_ptr root, node_ptr hint, const Value& val, node_ptr& parent, bool& left) const {
+            if (root && !hint && _compare(_header->right->pair, val)) {
+                parent = _header->right;
+                left = false;
+                return 0;
+            }
+            if (root && hint && _compare(val, hint->pair)) {
+                node_ptr before = prev_node(hint);
+                if (!before || _compare(before->pair, val)) {
+                    left = !hint->left;
+                    parent = left ? hint : before;
+                    return 0;
                 }
-                delete_node(remove);
-                return true;
             }
-            return false;
+            else if (root && hint && _compare(hint->pair, val)) {
+                node_ptr after = next_node(hint);
+                if (!after || _compare(val, after->pair)) {
+                    left = hint->right != 0;
+                    parent = left ? after : hint;
+                    return 0;
+                }
+            }
+            else if (root && hint)
+                return hint;
+            return insert_position(root, val, parent, left);
         }
 
-        node_ptr erase_left(node_ptr some, node_ptr* root) {
-            node_ptr replace = max_node(some->left);
+//		Makes *root a copy of the tree under source: shape and colours are copied node by node in O(n) without a single comparison.
+//		The nodes already under *root are recycled for the copy before any new node is taken from the pool.
+        void assign(node_ptr* root, const Tree& other, node_ptr source) {
+            node_ptr spare = 0;
+
+            harvest(*root, spare);
+            *root = 0;
+            _compare = other._compare;
+            try {
+                if (source)
+                    *root = clone(source, 0, spare);
+            } catch (...) {
+                release_spare(spare);
+                reset_extremes(0);
+                throw;
+            }
+            release_spare(spare);
+            reset_extremes(*root);
+        }
 
-            if (replace) {
-                if (replace == some->left) {
-                    some->left = replace->left;
-                    if (replace->left)
-                        replace->left->parent = some;
+//		Destroys the values under some and chains their nodes through right, flattening the tree like destroy().
+        void harvest(node_ptr some, node_ptr& spare) {
+            while (some) {
+                node_ptr next;
+                if (some->left) {
+                    next = some->left;
+                    some->left = next->right;
+                    next->right = some;
                 }
                 else {
-                    replace->parent->right = replace->left;
-                    if (replace->left)
-                        replace->left->parent = replace->parent;
-                }
-                if (replace->isBlack == true) {
-                    if (replace->left && replace->left->isBlack == false)
-                        replace->left->isBlack = true;
-                    erase_balance(root, replace->parent);
+                    next = some->right;
+                    _alloc.destroy(some);
+                    some->right = spare;
+                    spare = some;
                 }
+                some = next;
             }
-            return replace;
         }
 
-        node_ptr erase_right(node_ptr some, node_ptr* root) {
-            node_ptr replace = min_node(some->right);
+        void release_spare(node_ptr& spare) {
+            while (spare) {
+                node_ptr next = spare->right;
+                _pool.deallocate(spare);
+                spare = next;
+            }
+        }
 
-            if (replace) {
-                if (replace == some->right) {
-                    some->right = replace->right;
-                    if (replace->right)
-                        replace->right->parent = some;
-                }
-                else {
-                    replace->parent->left = replace->right;
-                    if (replace->right)
-                        replace->right->parent = replace->parent;
+        node_ptr recycle(const Value& val, node_ptr& spare) {
+            if (!spare)
+                return create_node(val);
+            node_ptr some = spare;
+            spare = some->right;
+            try {
+                _alloc.construct(some, val);
+            } catch (...) {
+                some->right = spare;
+                spare = some;
+                throw;
+            }
+            return some;
+        }
+
+//		Recurses into right subtrees and loops down the left spine, so the depth stays within the height.
+        node_ptr clone(node_ptr source, node_ptr parent, node_ptr& spare) {
+            node_ptr top = recycle(source->pair, spare);
+
+            top->set_black(source->is_black());
+            set_subtree_count(top, subtree_count(source));
+            top->set_parent(parent);
+            try {
+                if (source->right)
+                    top->right = clone(source->right, top, spare);
+                parent = top;
+                source = source->left;
+                while (source) {
+                    node_ptr some = recycle(source->pair, spare);
+                    some->set_black(source->is_black());
+                    set_subtree_count(some, subtree_count(source));
+                    some->set_parent(parent);
+                    parent->left = some;
+                    if (source->right)
+                        some->right = clone(source->right, some, spare);
+                    parent = some;
+                    source = source->left;
                 }
-                if (replace->isBlack == true) {
-                    if (replace->right && replace->right->isBlack == false)
-                        replace->right->isBlack = true;
-                    erase_balance(root, replace->parent);
+            } catch (...) {
+                destroy(&top);
+                throw;
+            }
+            return top;
+        }
+
+//		Whether [first, last) is strictly increasing, i.e. sorted without duplicates.
+        template <class ForwardIterator>
+        bool is_sorted_unique(ForwardIterator first, ForwardIterator last) const {
+            if (first == last)
+                return true;
+            for (ForwardIterator next = first; ++next != last; first = next) {
+                if (!_compare(as_value(*first), as_value(*next)))
+                    return false;
+            }
+            return true;
+        }
+
+//		Builds a perfectly balanced tree from n sorted unique values in O(n), *root must be empty.
+//		Subtrees split evenly, so every level but the deepest is full: the deepest level is red when it is incomplete, all the others black.
+        template <class ForwardIterator>
+        void build(node_ptr* root, ForwardIterator first, size_t n) {
+            size_t full = 0;
+
+            while ((size_t(2) << full) - 1 <= n)
+                ++full;
+            _pool.reserve(n);
+            *root = build(first, n, 0, full);
+            if (*root)
+                (*root)->set_parent(0);
+            reset_extremes(*root);
+        }
+
+        template <class ForwardIterator>
+        node_ptr build(ForwardIterator& first, size_t n, size_t depth, size_t red_depth) {
+            if (!n)
+                return 0;
+            size_t left_size = (n - 1) / 2;
+            node_ptr left = build(first, left_size, depth + 1, red_depth);
+            node_ptr some = 0;
+            try {
+                some = create_node(*first);
+            } catch (...) {
+                destroy(&left);
+                throw;
+            }
+            ++first;
+            some->left = left;
+            if (left)
+                left->set_parent(some);
+            some->set_black(depth != red_depth);
+            set_subtree_count(some, n);
+            try {
+                some->right = build(first, n - 1 - left_size, depth + 1, red_depth);
+            } catch (...) {
+                destroy(&some);
+                throw;
+            }
+            if (some->right)
+                some->right->set_parent(some);
+            return some;
+        }
+
+        static const Value& as_value(const Value& val) {
+            return val;
+        }
+
+//		Creates a node for val as the left or right child of parent, which must be free, and rebalances.
+        node_ptr link(node_ptr* root, node_ptr parent, bool left, const Value& val) {
+            node_ptr new_node = create_node(val);
+
+            link_node(root, parent, left, new_node);
+            return new_node;
+        }
+
+        void link_node(node_ptr* root, node_ptr parent, bool left, node_ptr new_node) {
+            new_node->left = 0;
+            new_node->right = 0;
+            new_node->set_black(false);
+            set_subtree_count(new_node, 1);
+            new_node->set_parent(parent);
+            if (!parent) {
+                *root = new_node;
+                new_node->set_black(true);
+                _header->left = new_node;
+                _header->right = new_node;
+            }
+            else if (left) {
+                parent->left = new_node;
+                if (parent == _header->left)
+                    _header->left = new_node;
+            }
+            else {
+                parent->right = new_node;
+                if (parent == _header->right)
+                    _header->right = new_node;
+            }
+            adjust_subtree_counts(parent, true);
+            insert_balance(root, new_node);
+        }
+
+        node_ptr next_node(node_ptr some) const {
+            if (some->right)
+                return min_node(some->right);
+            while (some->get_parent() && some->get_parent()->right == some)
+                some = some->get_parent();
+            return some->get_parent();
+        }
+
+        node_ptr prev_node(node_ptr some) const {
+            if (some->left)
+                return max_node(some->left);
+            while (some->get_parent() && some->get_parent()->left == some)
+                some = some->get_parent();
+            return some->get_parent();
+        }
+
+#ifdef FT_ORDER_STATISTICS
+//		Number of nodes less than key.
+        template <class K>
+        size_t rank(node_ptr root, const K& key) const {
+            size_t res = 0;
+
+            while (root) {
+                if (_compare(root->pair, key)) {
+                    res += subtree_count(root->left) + 1;
+                    root = root->right;
                 }
+                else
+                    root = root->left;
             }
-            return replace;
+            return res;
         }
+#endif
 
-        node_ptr erase_not_child(node_ptr some, node_ptr* root) {
-            node_ptr replace = some;
+        template <class K>
+        bool erase(node_ptr* root, const K& key) {
+            node_ptr remove = find_node(*root, key);
 
-            if (replace && replace->parent) {
-                if (replace->parent->right == replace)
-                    replace->parent->right = 0;
+            if (!remove)
+                return false;
+            erase_node(root, remove);
+            return true;
+        }
+
+//		Unlinks and deletes a node that is known to be in the tree, no search involved.
+        void erase_node(node_ptr* root, node_ptr some) {
+            unlink_node(root, some);
+            delete_node(some);
+        }
+
+//		Takes a node out of the tree and leaves it to the caller, its links are stale.
+//		A node with two children is replaced by its successor, then the colours are fixed from the place the removed node left.
+        void unlink_node(node_ptr* root, node_ptr some) {
+            node_ptr moved = some;
+            node_ptr child;
+            node_ptr child_parent;
+
+            if (some == _header->left)
+                _header->left = next_node(some);
+            if (some == _header->right)
+                _header->right = prev_node(some);
+            if (!some->left)
+                child = some->right;
+            else if (!some->right)
+                child = some->left;
+            else {
+                moved = min_node(some->right);
+                child = moved->right;
+            }
+            adjust_subtree_counts(moved->get_parent(), false);
+            if (moved != some) {
+                some->left->set_parent(moved);
+                moved->left = some->left;
+                if (moved != some->right) {
+                    child_parent = moved->get_parent();
+                    if (child)
+                        child->set_parent(child_parent);
+                    child_parent->left = child;
+                    moved->right = some->right;
+                    some->right->set_parent(moved);
+                }
                 else
-                    replace->parent->left = 0;
-                if (replace->isBlack == true) {
-                    if (replace->right && replace->right->isBlack == false)
-                        replace->right->isBlack = true;
-                    erase_balance(root, replace->parent);
+                    child_parent = moved;
+                replace_child(root, some, moved);
+                bool color = moved->is_black();
+                moved->set_black(some->is_black());
+                some->set_black(color);
+                set_subtree_count(moved, subtree_count(some));
+            }
+            else {
+                child_parent = some->get_parent();
+                replace_child(root, some, child);
+            }
+            if (some->is_black())
+                erase_balance(root, child, child_parent);
+        }
+
+//		Erases the nodes from first up to last (0 for end) walking successors, returns how many were erased.
+        size_t erase_range(node_ptr* root, node_ptr first, node_ptr last) {
+            size_t count = 0;
+
+            while (first != last) {
+                node_ptr next = next_node(first);
+                erase_node(root, first);
+                first = next;
+                ++count;
+            }
+            return count;
+        }
+
+//		Lets this tree take over nodes of other: they stay in slabs of the other pool, which are kept alive as long as this one.
+        void share_pool(Tree& other) {
+            _pool.borrow(other._pool);
+        }
+
+//		A node unlinked from this tree keeps the arenas of the pool alive through a pin, a tree it is linked into then adopts them.
+        pin_type pin() {
+            return _pool.pin();
+        }
+
+        void adopt(pin_type pin) {
+            _pool.adopt(pin);
+        }
+
+//		Copy of the tree under source, made of nodes of this tree.
+        node_ptr copy(node_ptr source) {
+            node_ptr spare = 0;
+
+            if (!source)
+                return 0;
+            return clone(source, 0, spare);
+        }
+
+#ifdef FT_ORDER_STATISTICS
+        template <class K>
+        size_t count_below(node_ptr root, const K& key, size_t) const {
+            return rank(root, key);
+        }
+#else
+//		Number of nodes less than key out of size, counted from whichever end of the tree is closer to it.
+        template <class K>
+        size_t count_below(node_ptr root, const K& key, size_t size) const {
+            node_ptr bound = lower(root, key);
+            node_ptr front = _header->left;
+            node_ptr back = bound;
+            size_t steps = 0;
+
+            while (front != bound && back) {
+                front = next_node(front);
+                back = next_node(back);
+                ++steps;
+            }
+            return front == bound ? steps : size - steps;
+        }
+#endif
+
+//		Join and split work on detached trees: a root without parent, always black, and its black height (black nodes on any path down, 0 when empty).
+//		Whole trees come in and go out through *root, where the extremes cached in the header are brought up to date.
+
+        static size_t black_height(node_ptr some) {
+            size_t height = 0;
+
+            for (; some; some = some->left)
+                height += some->is_black();
+            return height;
+        }
+
+//		Detaches a child of a node of black height height and blackens it if needed, which gives its own black height.
+        static node_ptr detach(node_ptr child, size_t height, size_t& child_height) {
+            child_height = height - 1;
+            if (child) {
+                child->set_parent(0);
+                if (!child->is_black()) {
+                    child->set_black(true);
+                    ++child_height;
                 }
             }
-            return replace;
+            return child;
         }
 
-        void erase_balance(node_ptr* root, node_ptr some) {
-            node_ptr right;
+//		Takes both children off the root some, which is left alone.
+        static void cut(node_ptr some, size_t height, node_ptr& left, size_t& left_height, node_ptr& right, size_t& right_height) {
+            left = detach(some->left, height, left_height);
+            right = detach(some->right, height, right_height);
+            some->left = 0;
+            some->right = 0;
+        }
+
+//		Joins the trees left < mid < right into one, mid being a lone node.
+//		The taller tree is descended along its inner spine down to a black node as high as the other tree, mid is linked there in red and rebalanced like an insert: O(difference of the heights).
+        node_ptr join(node_ptr left, size_t left_height, node_ptr mid, node_ptr right, size_t right_height, size_t& height) {
+            mid->set_parent(0);
+            if (left_height == right_height) {
+                mid->left = left;
+                mid->right = right;
+                if (left)
+                    left->set_parent(mid);
+                if (right)
+                    right->set_parent(mid);
+                mid->set_black(true);
+                set_subtree_count(mid, subtree_count(left) + subtree_count(right) + 1);
+                height = left_height + 1;
+                return mid;
+            }
+            bool left_taller = left_height > right_height;
+            node_ptr root = left_taller ? left : right;
+            node_ptr shorter = left_taller ? right : left;
+            size_t depth = left_taller ? left_height : right_height;
+            size_t added = subtree_count(shorter) + 1;
+            node_ptr parent = 0;
+            node_ptr some = root;
+
+            height = depth;
+            while (some && (!some->is_black() || depth != (left_taller ? right_height : left_height))) {
+                if (some->is_black())
+                    --depth;
+                set_subtree_count(some, subtree_count(some) + added);
+                parent = some;
+                some = left_taller ? some->right : some->left;
+            }
+            mid->set_parent(parent);
+            mid->set_black(false);
+            if (left_taller) {
+                parent->right = mid;
+                mid->left = some;
+                mid->right = shorter;
+            }
+            else {
+                parent->left = mid;
+                mid->left = shorter;
+                mid->right = some;
+            }
+            if (some)
+                some->set_parent(mid);
+            if (shorter)
+                shorter->set_parent(mid);
+            set_subtree_count(mid, subtree_count(some) + added);
+            height += insert_balance(&root, mid);
+            return root;
+        }
+
+//		Joins left < right without a middle node: the least node of right is split off to stand in for one.
+        node_ptr join(node_ptr left, size_t left_height, node_ptr right, size_t right_height, size_t& height) {
+            node_ptr none;
+            size_t none_height;
+
+            if (!left || !right) {
+                height = left ? left_height : right_height;
+                return left ? left : right;
+            }
+            node_ptr mid = split(right, right_height, min_node(right)->pair, none, none_height, right, right_height);
+            return join(left, left_height, mid, right, right_height, height);
+        }
+
+//		Splits the tree root around key into the trees less and greater, and returns the detached node equal to key or 0.
+//		Every level joins what it cut off back onto the part going up, the costs telescope to O(log n).
+        template <class K>
+        node_ptr split(node_ptr root, size_t height, const K& key, node_ptr& less, size_t& less_height, node_ptr& greater, size_t& greater_height) {
             node_ptr left;
+            node_ptr right;
+            node_ptr rest;
+            size_t left_height;
+            size_t right_height;
+            size_t rest_height;
+
+            if (!root) {
+                less = 0;
+                greater = 0;
+                less_height = 0;
+                greater_height = 0;
+                return 0;
+            }
+            cut(root, height, left, left_height, right, right_height);
+            if (_compare(key, root->pair)) {
+                node_ptr found = split(left, left_height, key, less, less_height, rest, rest_height);
+                greater = join(rest, rest_height, root, right, right_height, greater_height);
+                return found;
+            }
+            if (_compare(root->pair, key)) {
+                node_ptr found = split(right, right_height, key, rest, rest_height, greater, greater_height);
+                less = join(left, left_height, root, rest, rest_height, less_height);
+                return found;
+            }
+            less = left;
+            less_height = left_height;
+            greater = right;
+            greater_height = right_height;
+            return root;
+        }
+
+//		Leaves the nodes less than key under *root and returns the tree of the others.
+        template <class K>
+        node_ptr split_off(node_ptr* root, const K& key) {
+            node_ptr greater;
+            size_t greater_height;
+            size_t less_height;
+            size_t height;
+
+            node_ptr found = split(*root, black_height(*root), key, *root, less_height, greater, greater_height);
+            if (found)
+                greater = join(0, 0, found, greater, greater_height, height);
+            reset_extremes(*root);
+            return greater;
+        }
+
+//		Adds the detached tree source to *root: in O(log n) when all of source comes after *root, otherwise as a union.
+//		Returns the number of nodes of source dropped as duplicates.
+        size_t join(node_ptr* root, node_ptr source) {
+            size_t height;
+
+            if (*root && source && !_compare(_header->right->pair, min_node(source)->pair))
+                return unite(root, source);
+            *root = join(*root, black_height(*root), source, black_height(source), height);
+            reset_extremes(*root);
+            return 0;
+        }
+
+//		Set algebra between *root and the detached tree source, whose nodes are used up: the result stays under *root.
+//		Every node of source splits *root and the halves are handled recursively, O(m log(n / m + 1)) for m nodes in source.
+//		Each returns the number of keys found in both trees; on a match the node of *root is the one kept.
+        size_t unite(node_ptr* root, node_ptr source) {
+            size_t matched = 0;
+            size_t height;
+
+            *root = unite(*root, black_height(*root), source, black_height(source), height, matched);
+            reset_extremes(*root);
+            return matched;
+        }
+
+        size_t intersect(node_ptr* root, node_ptr source) {
+            size_t matched = 0;
+            size_t height;
+
+            *root = intersect(*root, black_height(*root), source, black_height(source), height, matched);
+            reset_extremes(*root);
+            return matched;
+        }
+
+        size_t subtract(node_ptr* root, node_ptr source) {
+            size_t matched = 0;
+            size_t height;
+
+            *root = subtract(*root, black_height(*root), source, black_height(source), height, matched);
+            reset_extremes(*root);
+            return matched;
+        }
+
+        node_ptr unite(node_ptr some, size_t some_height, node_ptr other, size_t other_height, size_t& height, size_t& matched) {
+            node_ptr left, right, less, greater;
+            size_t left_height, right_height, less_height, greater_height;
+
+            if (!some || !other) {
+                height = some ? some_height : other_height;
+                return some ? some : other;
+            }
+            cut(other, other_height, left, left_height, right, right_height);
+            if (other_height <= 2) {
+                some = place(some, some_height, other, some_height, matched);
+                some = unite(some, some_height, left, left_height, some_height, matched);
+                return unite(some, some_height, right, right_height, height, matched);
+            }
+            node_ptr found = split(some, some_height, other->pair, less, less_height, greater, greater_height);
+            if (found) {
+                delete_node(other);
+                other = found;
+                ++matched;
+            }
+            less = unite(less, less_height, left, left_height, less_height, matched);
+            greater = unite(greater, greater_height, right, right_height, greater_height, matched);
+            return join(less, less_height, other, greater, greater_height, height);
+        }
+
+//		Links the lone node single into some by a plain descent, or deletes it if its key is already there.
+//		Near the bottom of source the parts of some left to search are small, so this keeps the bound and saves a split and a join per node.
+        node_ptr place(node_ptr some, size_t some_height, node_ptr single, size_t& height, size_t& matched) {
+            node_ptr parent = 0;
+            node_ptr tmp = some;
+            bool left = true;
+
+            while (tmp) {
+                parent = tmp;
+                left = _compare(single->pair, tmp->pair);
+                tmp = left ? tmp->left : tmp->right;
+            }
+            node_ptr before = parent;
+            if (left)
+                before = prev_node(parent);
+            height = some_height;
+            if (before && !_compare(before->pair, single->pair)) {
+                delete_node(single);
+                ++matched;
+                return some;
+            }
+            single->set_parent(parent);
+            single->set_black(false);
+            set_subtree_count(single, 1);
+            if (left)
+                parent->left = single;
+            else
+                parent->right = single;
+            adjust_subtree_counts(parent, true);
+            height += insert_balance(&some, single);
+            return some;
+        }
+
+        node_ptr intersect(node_ptr some, size_t some_height, node_ptr other, size_t other_height, size_t& height, size_t& matched) {
+            node_ptr left, right, less, greater;
+            size_t left_height, right_height, less_height, greater_height;
+
+            if (!some || !other) {
+                destroy(&some);
+                destroy(&other);
+                height = 0;
+                return 0;
+            }
+            cut(other, other_height, left, left_height, right, right_height);
+            node_ptr found = split(some, some_height, other->pair, less, less_height, greater, greater_height);
+            delete_node(other);
+            less = intersect(less, less_height, left, left_height, less_height, matched);
+            greater = intersect(greater, greater_height, right, right_height, greater_height, matched);
+            if (!found)
+                return join(less, less_height, greater, greater_height, height);
+            ++matched;
+            return join(less, less_height, found, greater, greater_height, height);
+        }
+
+        node_ptr subtract(node_ptr some, size_t some_height, node_ptr other, size_t other_height, size_t& height, size_t& matched) {
+            node_ptr left, right, less, greater;
+            size_t left_height, right_height, less_height, greater_height;
+
+            if (!some || !other) {
+                destroy(&other);
+                height = some_height;
+                return some;
+            }
+            cut(other, other_height, left, left_height, right, right_height);
+            node_ptr found = split(some, some_height, other->pair, less, less_height, greater, greater_height);
+            delete_node(other);
+            if (found) {
+                delete_node(found);
+                ++matched;
+            }
+            less = subtract(less, less_height, left, left_height, less_height, matched);
+            greater = subtract(greater, greater_height, right, right_height, greater_height, matched);
+            return join(less, less_height, greater, greater_height, height);
+        }
+
+//		Puts replace where some hangs from its parent, or at the root.
+        void replace_child(node_ptr* root, node_ptr some, node_ptr replace) {
+            if (!some->get_parent())
+                *root = replace;
+            else if (some->get_parent()->left == some)
+                some->get_parent()->left = replace;
+            else
+                some->get_parent()->right = replace;
+            if (replace)
+                replace->set_parent(some->get_parent());
+        }
+
+//		Removing a black node left the path through some one black short, some may be 0 so its parent is passed along.
+        void erase_balance(node_ptr* root, node_ptr some, node_ptr parent) {
             node_ptr brother;
 
-            while (some != *root && some->isBlack) {
-                brother = some->right;
-                if (brother) {
-                    right = brother->right;
-                    left = brother->left;
-                    if ((right || left) && (!right || right->isBlack == true) && (!left || left->isBlack == true)) {
-                        if (brother->isBlack == true) {
-                            brother->isBlack = false;
-                            some->isBlack = true;
-                            rotate_left(some, root);
-                        }
-                        else
-                            some = some->parent;
+            while (some != *root && (!some || some->is_black())) {
+                if (some == parent->left) {
+                    brother = parent->right;
+                    if (!brother->is_black()) {
+                        brother->set_black(true);
+                        parent->set_black(false);
+                        rotate_left(parent, root);
+                        brother = parent->right;
+                    }
+                    if ((!brother->left || brother->left->is_black()) && (!brother->right || brother->right->is_black())) {
+                        brother->set_black(false);
+                        some = parent;
+                        parent = parent->get_parent();
                     }
-                    else if (right && brother->isBlack == true) {
-                        if (left && left->isBlack == false && right->isBlack == true) {
+                    else {
+                        if (!brother->right || brother->right->is_black()) {
+                            brother->left->set_black(true);
+                            brother->set_black(false);
                             rotate_right(brother, root);
-                            right = brother;
-                            brother = left;
+                            brother = parent->right;
                         }
-                        if (right->isBlack == false && (!left || left->isBlack == true || !some->left))
-                            rotate_left(some, root);
-                        else
-                            some = some->parent;
+                        brother->set_black(parent->is_black());
+                        parent->set_black(true);
+                        if (brother->right)
+                            brother->right->set_black(true);
+                        rotate_left(parent, root);
+                        break;
+                    }
+                }
+                else {
+                    brother = parent->left;
+                    if (!brother->is_black()) {
+                        brother->set_black(true);
+                        parent->set_black(false);
+                        rotate_right(parent, root);
+                        brother = parent->left;
                     }
-                    else if (brother->isBlack == true && some->isBlack == false) {
-                        some->isBlack = true;
-                        brother->isBlack = false;
-                        some = some->parent;
+                    if ((!brother->right || brother->right->is_black()) && (!brother->left || brother->left->is_black())) {
+                        brother->set_black(false);
+                        some = parent;
+                        parent = parent->get_parent();
+                    }
+                    else {
+                        if (!brother->left || brother->left->is_black()) {
+                            brother->right->set_black(true);
+                            brother->set_black(false);
+                            rotate_left(brother, root);
+                            brother = parent->left;
+                        }
+                        brother->set_black(parent->is_black());
+                        parent->set_black(true);
+                        if (brother->left)
+                            brother->left->set_black(true);
+                        rotate_right(parent, root);
+                        break;
                     }
-                    else
-                        some = some->parent;
                 }
-                else
-                    break;
             }
+            if (some)
+                some->set_black(true);
         }
 
+//		Rotations only relink, the callers set the colours.
         void rotate_left(node_ptr node, node_ptr* root) {
             node_ptr right = node->right;
-            right->parent = node->parent;
 
-            if (right->parent) {
-                if (right->parent->right == node)
-                    right->parent->right = right;
-                else
-                    right->parent->left = right;
-            }
-            node->parent = right;
             node->right = right->left;
-            if (node->right) {
-                if (node->right->parent == right)
-                    node->right->parent = node;
-                else
-                    node->right->parent = node;
-            }
+            if (node->right)
+                node->right->set_parent(node);
+            replace_child(root, node, right);
             right->left = node;
-            bool color = node->isBlack;
-            node->isBlack = right->isBlack;
-            right->isBlack = color;
-            if (!right->parent)
-                *root = right;
+            node->set_parent(right);
+            set_subtree_count(right, subtree_count(node));
+            set_subtree_count(node, subtree_count(node->left) + subtree_count(node->right) + 1);
         }
 
         void rotate_right(node_ptr some, node_ptr* root) {
             node_ptr left = some->left;
-            left->parent = some->parent;
-			
-            if (left->parent) {
-                if (left->parent->left == some)
-                    left->parent->left = left;
-                else
-                    left->parent->right = left;
-            }
-            some->parent = left;
+
             some->left = left->right;
-            if (some->left) {
-                if (some->left->parent == left)
-                    some->left->parent = some;
-                else
-                    some->left->parent = some;
-            }
+            if (some->left)
+                some->left->set_parent(some);
+            replace_child(root, some, left);
             left->right = some;
-            some->isBlack = false;
-            left->isBlack = true;
-            if (!left->parent)
-                *root = left;
+            some->set_parent(left);
+            set_subtree_count(left, subtree_count(some));
+            set_subtree_count(some, subtree_count(some->left) + subtree_count(some->right) + 1);
         }
     };
 }
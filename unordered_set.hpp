@@ -0,0 +1,237 @@
+#pragma once
+
+#include "iterator.hpp"
+#include "utils.hpp"
+#include "hash_table.hpp"
+
+namespace ft {
+//	Hash set on an open addressing table: one hash and, most of the time, one slot compared per lookup, for membership tests that need no order.
+//	Iterators are forward only and run in table order. An insert that makes the table grow invalidates them, an erase only the erased one.
+    template <class Key, class Hash = ft::hash<Key>, class KeyEqual = ft::equal_to<Key>, class Alloc = std::allocator<Key> >
+    class unordered_set {
+    public:
+        typedef Key										key_type;
+        typedef key_type								value_type;
+        typedef Hash									hasher;
+        typedef KeyEqual								key_equal;
+        typedef Alloc									allocator_type;
+        typedef value_type&								reference;
+        typedef const value_type&						const_reference;
+        typedef typename allocator_type::pointer		pointer;
+        typedef typename allocator_type::const_pointer	const_pointer;
+        typedef ft::hash_iterator<const value_type>		iterator;
+        typedef ft::hash_iterator<const value_type>		const_iterator;
+        typedef size_t									size_type;
+        typedef std::ptrdiff_t							difference_type;
+    private:
+//		Return type R for lookups by a key of type K, only when both Hash and KeyEqual are transparent.
+        template <class K, class R>
+        struct enable_if_transparent : public ft::enable_if<ft::is_transparent<Hash>::value && ft::is_transparent<KeyEqual>::value, R> {};
+
+        typedef ft::HashTable<value_type, hasher, key_equal, Alloc>	table_type;
+
+        table_type		_table;
+        allocator_type	_alloc;
+    public:
+        explicit unordered_set(size_type n = 0, const hasher& hash = hasher(), const key_equal& equal = key_equal(), const allocator_type& alloc = allocator_type()) : _table(alloc, hash, equal), _alloc(alloc) {
+            if (n)
+                _table.rehash(n);
+        }
+
+        template <class InputIterator>
+        unordered_set(InputIterator first, InputIterator last, size_type n = 0, const hasher& hash = hasher(), const key_equal& equal = key_equal(), const allocator_type& alloc = allocator_type()) : _table(alloc, hash, equal), _alloc(alloc) {
+            if (n)
+                _table.rehash(n);
+            insert(first, last);
+        }
+
+        ~unordered_set() {}
+
+        unordered_set(const unordered_set& other) : _table(other._alloc, other._table.hash_function(), other._table.key_eq()), _alloc(other._alloc) {
+            *this = other;
+        }
+
+        unordered_set& operator=(const unordered_set& other) {
+            if (this != &other) {
+                _table.assign(other._table);
+                _alloc = other._alloc;
+            }
+            return *this;
+        }
+
+	//	************ iterators *************
+
+        const_iterator begin() const {
+            return _table.begin();
+        }
+
+        const_iterator end() const {
+            return _table.end();
+        }
+
+        bool empty() const {
+            return _table.size() == 0;
+        }
+
+        size_type size() const {
+            return _table.size();
+        }
+
+        size_type max_size() const {
+            return _table.max_size();
+        }
+
+	//	************ funcs **********
+
+        ft::pair<iterator, bool> insert(const value_type& val) {
+            return _table.insert(val);
+        }
+
+//		The hint is of no use to a hash table, it is there for the interface of map.
+        iterator insert(const_iterator, const value_type& val) {
+            return _table.insert(val).first;
+        }
+
+//		A forward range makes room for all of its elements first.
+        template <class InputIterator>
+        void insert(InputIterator first, InputIterator last) {
+            insert_range(first, last, typename ft::iterator_traits<InputIterator>::iterator_category());
+        }
+    private:
+        template <class InputIterator>
+        void insert_range(InputIterator first, InputIterator last, std::input_iterator_tag) {
+            for (; first != last; ++first)
+                _table.insert(*first);
+        }
+
+        template <class ForwardIterator>
+        void insert_range(ForwardIterator first, ForwardIterator last, std::forward_iterator_tag) {
+            _table.reserve(size() + ft::distance(first, last));
+            for (; first != last; ++first)
+                _table.insert(*first);
+        }
+    public:
+        void erase(const_iterator position) {
+            _table.erase(position);
+        }
+
+        size_type erase(const key_type& k) {
+            return _table.erase(k);
+        }
+
+        template <class K>
+        typename enable_if_transparent<K, size_type>::type erase(const K& k) {
+            return _table.erase(k);
+        }
+
+//		Values never move on erase, so the range is walked as it goes.
+        void erase(const_iterator first, const_iterator last) {
+            while (first != last)
+                _table.erase(first++);
+        }
+
+        void swap(unordered_set& x) {
+            allocator_type alloc = _alloc;
+            _table.swap(x._table);
+            _alloc = x._alloc;
+            x._alloc = alloc;
+        }
+
+        void clear() {
+            _table.clear();
+        }
+
+        hasher hash_function() const {
+            return _table.hash_function();
+        }
+
+        key_equal key_eq() const {
+            return _table.key_eq();
+        }
+
+        iterator find(const key_type& k) const {
+            return _table.find(k);
+        }
+
+        size_type count(const key_type& k) const {
+            if (_table.find(k) != _table.end())
+                return 1;
+            return 0;
+        }
+
+        ft::pair <const_iterator, const_iterator> equal_range(const key_type& k) const {
+            const_iterator it = find(k);
+
+            if (it == end())
+                return ft::make_pair(it, it);
+            const_iterator next = it;
+            return ft::make_pair(it, ++next);
+        }
+
+//		Heterogeneous lookup with a transparent Hash and ft::equal_to<void>.
+        template <class K>
+        typename enable_if_transparent<K, const_iterator>::type find(const K& k) const {
+            return _table.find(k);
+        }
+
+        template <class K>
+        typename enable_if_transparent<K, size_type>::type count(const K& k) const {
+            if (_table.find(k) != _table.end())
+                return 1;
+            return 0;
+        }
+
+	//	************ hash policy **********
+
+        size_type bucket_count() const {
+            return _table.bucket_count();
+        }
+
+        float load_factor() const {
+            return _table.load_factor();
+        }
+
+        float max_load_factor() const {
+            return _table.max_load_factor();
+        }
+
+//		Share of the slots that may be taken before the table grows, in (0, 1], 0.875 by default.
+        void max_load_factor(float ml) {
+            _table.max_load_factor(ml);
+        }
+
+        void rehash(size_type n) {
+            _table.rehash(n);
+        }
+
+        void reserve(size_type n) {
+            _table.reserve(n);
+        }
+
+        allocator_type get_allocator() const {
+            return _alloc;
+        }
+    };
+
+//	Same keys, whatever the order of the tables.
+    template <class Key, class Hash, class KeyEqual, class Allocator>
+    bool operator==(const unordered_set<Key, Hash, KeyEqual, Allocator>& x, const unordered_set<Key, Hash, KeyEqual, Allocator>& y) {
+        if (x.size() != y.size())
+            return false;
+        for (typename unordered_set<Key, Hash, KeyEqual, Allocator>::const_iterator it = x.begin(); it != x.end(); ++it) {
+            if (y.find(*it) == y.end())
+                return false;
+        }
+        return true;
+    }
+
+    template <class Key, class Hash, class KeyEqual, class Allocator>
+    bool operator!=(const unordered_set<Key, Hash, KeyEqual, Allocator>& x, const unordered_set<Key, Hash, KeyEqual, Allocator>& y) {
+        return !(x == y);
+    }
+
+    template <class Key, class Hash, class KeyEqual, class Allocator>
+    void swap(unordered_set<Key, Hash, KeyEqual, Allocator>& x, unordered_set<Key, Hash, KeyEqual, Allocator>& y) {
+        x.swap(y);
+    }
+}
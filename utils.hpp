@@ -1,5 +1,13 @@
 #pragma once
 
+#include <iterator>
+#if __cplusplus >= 201103L
+# include <type_traits>
+# include <utility>
+#endif
+#if !defined(__i386__) && !defined(__x86_64__)
+# include <sched.h>
+#endif
 #include "traits.hpp"
 
 namespace ft {
@@ -27,6 +35,56 @@ namespace ft {
 		}
 	};
 
+//	Transparent less: compares any two types with operator<, so map and set lookups can take a key of another type.
+	template <>
+	struct less<void> {
+		typedef void is_transparent;
+
+		template <class T, class U>
+		bool operator()(const T& x, const U& y) const {
+			return x < y;
+		}
+	};
+
+	template <class T>
+	struct equal_to : binary_function <T, T, bool> {
+		bool operator()(const T& x, const T& y) const {
+			return x == y;
+		}
+	};
+
+//	Transparent equal_to, for heterogeneous lookup in unordered_map and unordered_set.
+	template <>
+	struct equal_to<void> {
+		typedef void is_transparent;
+
+		template <class T, class U>
+		bool operator()(const T& x, const U& y) const {
+			return x == y;
+		}
+	};
+
+//	Tag for map and set constructors and insert: the range is already sorted and free of duplicates.
+	struct sorted_unique_t {};
+
+	const sorted_unique_t sorted_unique = sorted_unique_t();
+
+//	Checks whether a comparator declares is_transparent, which allows heterogeneous lookup in map and set.
+	template <class T>
+	struct is_transparent {
+	private:
+		typedef char	yes;
+		typedef char	(&no)[2];
+
+		template <class U>
+		static yes test(typename U::is_transparent*);
+
+		template <class U>
+		static no test(...);
+	public:
+		static const bool value = sizeof(test<T>(0)) == sizeof(yes);
+	};
+
 //	Creates an integer constant from type and value.
     template <class T, bool val>
     struct integral_constant {
@@ -85,6 +143,86 @@ namespace ft {
 	template <>
 	struct is_integral<unsigned long long> : public ft::integral_constant<bool, true> {};
 
+	typedef integral_constant<bool, true>	true_type;
+	typedef integral_constant<bool, false>	false_type;
+
+//	Types whose objects can be moved to another address with memcpy and dropped without a destructor call, vector relocates and shifts them in bulk. Specialise it for your own types that qualify.
+#if defined(__GNUC__) || defined(__clang__)
+	template <class T>
+	struct is_trivially_relocatable : public ft::integral_constant<bool, __is_pod(T)> {};
+#else
+	template <class T>
+	struct is_trivially_relocatable : public ft::integral_constant<bool, ft::is_integral<T>::value> {};
+#endif
+
+	template <>
+	struct is_trivially_relocatable<float> : public ft::true_type {};
+
+	template <>
+	struct is_trivially_relocatable<double> : public ft::true_type {};
+
+	template <>
+	struct is_trivially_relocatable<long double> : public ft::true_type {};
+
+	template <class T>
+	struct is_trivially_relocatable<T*> : public ft::true_type {};
+
+//	Types whose copies can be made with memcpy and memset, vector fills them in bulk.
+//	Unlike relocation this is not to be specialised: a type that may be moved bitwise, a unique owner of some resource, still cannot be copied bitwise.
+#if defined(__GNUC__) || defined(__clang__)
+	template <class T>
+	struct is_trivially_copyable : public ft::integral_constant<bool, __is_pod(T)> {};
+#else
+	template <class T>
+	struct is_trivially_copyable : public ft::integral_constant<bool, ft::is_integral<T>::value> {};
+
+	template <>
+	struct is_trivially_copyable<float> : public ft::true_type {};
+
+	template <>
+	struct is_trivially_copyable<double> : public ft::true_type {};
+
+	template <>
+	struct is_trivially_copyable<long double> : public ft::true_type {};
+
+	template <class T>
+	struct is_trivially_copyable<T*> : public ft::true_type {};
+#endif
+
+//	Alignment requirement of T, measured from the padding the compiler puts in front of a T that follows a char.
+	template <class T>
+	struct alignment_of {
+	private:
+		struct probe {
+			char	c;
+			T		t;
+		};
+	public:
+		static const size_t value = sizeof(probe) - sizeof(T);
+	};
+
+//	Source of a relocation: moved from when its move constructor cannot throw (C++11 and later), copied otherwise.
+#if __cplusplus >= 201103L
+	template <class T>
+	typename std::conditional<!std::is_nothrow_move_constructible<T>::value && std::is_copy_constructible<T>::value, const T&, T&&>::type move_if_noexcept(T& x) noexcept {
+		return std::move_if_noexcept(x);
+	}
+#else
+	template <class T>
+	const T& move_if_noexcept(T& x) {
+		return x;
+	}
+#endif
+
+//	Body of a spin-wait loop: tells an x86 core that it spins, which frees the pipeline for the other hyperthread, and yields the CPU elsewhere.
+	inline void spin_pause() {
+#if defined(__i386__) || defined(__x86_64__)
+		__builtin_ia32_pause();
+#else
+		sched_yield();
+#endif
+	}
+
 //	"Metaprogramming" - compile-time programming
 //	SFINAE  — substitution failure is not an error
     template <bool Condition, class T = void> // compile time error is not an error
@@ -139,13 +277,48 @@ namespace ft {
         return true;
     }
 
-//	Distance between two iterators in size_type value.
-	template <class InputIt1, class InputIt2>
-	size_t distance(InputIt1 first, InputIt2 last) {
-		size_t distance = 0;
+//	Distance between two iterators: constant time for random access iterators, a walk over the range otherwise.
+	template <class InputIterator>
+	typename ft::iterator_traits<InputIterator>::difference_type distance(InputIterator first, InputIterator last, std::input_iterator_tag) {
+		typename ft::iterator_traits<InputIterator>::difference_type distance = 0;
 
 		for(; first != last; ++first)
 			distance++;
 		return distance;
 	}
+
+	template <class RandomAccessIterator>
+	typename ft::iterator_traits<RandomAccessIterator>::difference_type distance(RandomAccessIterator first, RandomAccessIterator last, std::random_access_iterator_tag) {
+		return last - first;
+	}
+
+	template <class InputIterator>
+	typename ft::iterator_traits<InputIterator>::difference_type distance(InputIterator first, InputIterator last) {
+		return ft::distance(first, last, typename ft::iterator_traits<InputIterator>::iterator_category());
+	}
+
+//	Moves an iterator n steps, in one jump for random access iterators and backwards as well for bidirectional ones.
+	template <class InputIterator, class Distance>
+	void advance(InputIterator& it, Distance n, std::input_iterator_tag) {
+		for (; n > 0; --n)
+			++it;
+	}
+
+	template <class BidirectionalIterator, class Distance>
+	void advance(BidirectionalIterator& it, Distance n, std::bidirectional_iterator_tag) {
+		for (; n > 0; --n)
+			++it;
+		for (; n < 0; ++n)
+			--it;
+	}
+
+	template <class RandomAccessIterator, class Distance>
+	void advance(RandomAccessIterator& it, Distance n, std::random_access_iterator_tag) {
+		it += n;
+	}
+
+	template <class InputIterator, class Distance>
+	void advance(InputIterator& it, Distance n) {
+		ft::advance(it, n, typename ft::iterator_traits<InputIterator>::iterator_category());
+	}
 }
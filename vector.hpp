@@ -1,11 +1,26 @@
 #pragma once
 
 #include <cstdlib>
+#include <cstring>
 #include <algorithm>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#if __cplusplus >= 201103L
+# include <memory>
+# include <utility>
+#endif
 #include "iterator.hpp"
 #include "utils.hpp"
 
 namespace ft {
+//	Growth policy of ft::vector: a full vector grows its capacity by numerator / denominator. Specialise it for a type to change the factor.
+    template <class T>
+    struct vector_growth {
+        static const size_t numerator = 2;
+        static const size_t denominator = 1;
+    };
+
     template <class T, class Allocator = std::allocator<T> >
     class vector {
     public:
@@ -21,7 +36,8 @@ namespace ft {
         typedef ft::reverse_iterator<const_iterator>					const_reverse_iterator;
 		typedef typename iterator_traits<iterator>::difference_type		difference_type;
         typedef size_t													size_type;
-    private:
+//	Protected so that small_vector can point the storage at its inline buffer.
+    protected:
         size_type       _size;
         size_type       _capacity;
         allocator_type	_alloc;
@@ -31,8 +47,6 @@ namespace ft {
         explicit vector(const allocator_type& alloc = allocator_type()) : _size(0), _capacity(0), _alloc(alloc), _pointer(0) {}
 
         explicit vector(size_type n, const value_type& val = value_type(), const allocator_type& alloc = allocator_type()) : _size(0), _capacity(0), _alloc(alloc), _pointer(0)  {
-            if (n < 0)
-                throw std::logic_error("Error: Incorrect size!");
             insert(begin(), n, val);
         }
 
@@ -44,9 +58,6 @@ namespace ft {
         vector& operator=(const vector& x) {
             if (this != &x) {
                 clear();
-                _alloc.deallocate(_pointer, _capacity);
-                _capacity = x.capacity();
-                _pointer = _alloc.allocate(_capacity);
                 insert(begin(), x.begin(), x.end());
             }
             return *this;
@@ -56,6 +67,30 @@ namespace ft {
             insert(begin(), x.begin(), x.end());
         }
 
+#if __cplusplus >= 201103L
+        vector(vector&& x) noexcept : _size(x._size), _capacity(x._capacity), _alloc(std::move(x._alloc)), _pointer(x._pointer) {
+            x._size = 0;
+            x._capacity = 0;
+            x._pointer = 0;
+        }
+
+        vector& operator=(vector&& x) noexcept {
+            if (this != &x) {
+                clear();
+                if (_capacity)
+                    _alloc.deallocate(_pointer, _capacity);
+                _alloc = std::move(x._alloc);
+                _size = x._size;
+                _capacity = x._capacity;
+                _pointer = x._pointer;
+                x._size = 0;
+                x._capacity = 0;
+                x._pointer = 0;
+            }
+            return *this;
+        }
+#endif
+
         ~vector() {
             clear();
             if (_capacity)
@@ -165,21 +200,10 @@ namespace ft {
         }
 
         void reserve(size_type newCapacity) {
-            if (newCapacity > max_size() || newCapacity < 0)
+            if (newCapacity > max_size())
                 throw std::logic_error("Error: Incorrect capacity value!");
-            else {
-				_capacity *= 2;
-                if (newCapacity < _capacity)
-					newCapacity = _capacity;
-                pointer tmp = _alloc.allocate(newCapacity);
-                for (size_type i = 0; i < _size; i++)
-                    _alloc.construct(tmp + i, _pointer[i]);
-                for (size_type i = 0; i < _size; ++i)
-                    _alloc.destroy(_pointer + i);
-                _alloc.deallocate(_pointer, _capacity);
-                _capacity = newCapacity;
-                _pointer = tmp;
-            }
+            if (newCapacity > _capacity)
+                reallocate(newCapacity, _size, 0);
         }
 
         void resize(size_type n, value_type val = value_type()) {
@@ -191,10 +215,59 @@ namespace ft {
         }
 
         void push_back(const value_type& val) {
-            reserve(_size + 1);
-            _alloc.construct(_pointer + _size, val);
+            if (_size == _capacity && inside(val)) {
+//				val lives in the buffer that is about to be released.
+                value_type copy(val);
+                reallocate(recommend(_size + 1), _size, 0);
+                _alloc.construct(_pointer + _size, ft::move_if_noexcept(copy));
+            }
+            else {
+                if (_size == _capacity)
+                    reallocate(recommend(_size + 1), _size, 0);
+                _alloc.construct(_pointer + _size, val);
+            }
+            _size++;
+        }
+
+#if __cplusplus >= 201103L
+        void push_back(value_type&& val) {
+            emplace_back(std::move(val));
+        }
+
+//		Builds the element in place from args, through a temporary only when the buffer has to grow under them.
+        template <class... Args>
+        void emplace_back(Args&&... args) {
+            if (_size == _capacity) {
+                value_type tmp(std::forward<Args>(args)...);
+                reallocate(recommend(_size + 1), _size, 0);
+                std::allocator_traits<allocator_type>::construct(_alloc, _pointer + _size, std::move(tmp));
+            }
+            else
+                std::allocator_traits<allocator_type>::construct(_alloc, _pointer + _size, std::forward<Args>(args)...);
+            _size++;
+        }
+
+        template <class... Args>
+        iterator emplace(iterator position, Args&&... args) {
+            size_type distance = static_cast<size_type>(ft::distance(begin(), position));
+
+            if (position > end() || position < begin())
+                throw std::logic_error("Error: Bad position index!");
+            if (distance == _size) {
+                emplace_back(std::forward<Args>(args)...);
+                return begin() + distance;
+            }
+            value_type tmp(std::forward<Args>(args)...);
+            make_gap(distance, 1);
+            std::allocator_traits<allocator_type>::construct(_alloc, _pointer + distance, std::move(tmp));
             _size++;
+            return begin() + distance;
+        }
+
+        iterator insert(iterator position, value_type&& val) {
+            return emplace(position, std::move(val));
         }
+#endif
 
         void pop_back() {
             if (_size) {
@@ -208,12 +281,15 @@ namespace ft {
 
             if (position > end() || position < begin())
                 throw std::logic_error("Error: Bad position index!/n");
-            reserve(_size + 1);
-            for (size_type i = 0; _size - i != distance; ++i) {
-                _alloc.construct(_pointer + _size - i, _pointer[_size - i - 1]);
-                _alloc.destroy(_pointer + _size - i - 1);
+            if (inside(val)) {
+                value_type copy(val);
+                make_gap(distance, 1);
+                _alloc.construct(_pointer + distance, ft::move_if_noexcept(copy));
+            }
+            else {
+                make_gap(distance, 1);
+                _alloc.construct(_pointer + distance, val);
             }
-            _alloc.construct(_pointer + distance, val);
             _size++;
             return iterator(begin() + distance);
         }
@@ -223,48 +299,25 @@ namespace ft {
 
             if (position > end() || position < begin())
                 throw std::logic_error("Error: Bad position index!");
-            reserve(_size + n);
-            for (size_type i = 0; _size - i != distance; ++i) {
-                _alloc.construct(_pointer + _size - 1 - i + n, _pointer[_size - i - 1]);
-                _alloc.destroy(_pointer + _size - i - 1);
+            if (inside(val)) {
+                value_type copy(val);
+                make_gap(distance, n);
+                fill(_pointer + distance, n, copy, copyable());
             }
-            for (size_type i = 0; i < n; i++) {
-                _alloc.construct(_pointer + distance + i, val);
-                _size++;
+            else {
+                make_gap(distance, n);
+                fill(_pointer + distance, n, val, copyable());
             }
+            _size += n;
         }
 
         template <class InputIterator>
         void insert(iterator position, InputIterator first, InputIterator last, typename ft::enable_if<!ft::is_integral<InputIterator>::value>::type* = 0) {
-            size_type n = static_cast<size_type>(ft::distance(first, last));
             size_type distance = static_cast<size_type>(ft::distance(begin(), position));
 
             if (position > end() || position < begin())
                 throw std::logic_error("Error: Bad position index!");
-            pointer tmp = _alloc.allocate(n);
-            try {
-                for (size_type i = 0; i < n; i++)
-                    _alloc.construct(tmp + i, *first++);
-            }
-//			Allows to handle any exception.
-            catch(...) {
-				for (size_type i = 0; tmp + i != 0 && i < n; i++) {
-                    _alloc.destroy(tmp + i);
-				}
-                _alloc.deallocate(tmp, n);
-                throw std::logic_error("Error: Common error");
-            }
-            reserve(_size + n);
-            for (size_type i = 0; _size - i != distance; ++i){
-                _alloc.construct(_pointer + _size - 1 - i + n, _pointer[_size - i - 1]);
-                _alloc.destroy(_pointer + _size - i - 1);
-            }
-            for (size_type i = 0; i < n; i++) {
-                _alloc.construct(_pointer + distance + i, tmp[i]);
-                _alloc.destroy(tmp + i);
-                _size++;
-            }
-            _alloc.deallocate(tmp, n);
+            range_insert(distance, first, last, typename ft::iterator_traits<InputIterator>::iterator_category());
         }
 
         iterator erase(iterator position) {
@@ -273,10 +326,7 @@ namespace ft {
             if (!_size)
                 return end();
             _alloc.destroy(_pointer + distance);
-            for (size_type i = 0; distance + i != _size; ++i) {
-                _alloc.construct(_pointer + distance + i, _pointer[distance + i + 1]);
-                _alloc.destroy(_pointer + distance + i + 1);
-            }
+            close_gap(distance, 1);
             _size--;
             return begin() + distance;
         }
@@ -287,13 +337,9 @@ namespace ft {
 
             if (_size == 0)
                 return end();
-            for (size_type i = 0; i != n; ++i)
-                _alloc.destroy(_pointer + distance + i);
+            destroy_range(_pointer + distance, n);
+            close_gap(distance, n);
             _size -= n;
-            for (size_type i = 0; distance + i != _size; ++i) {
-                _alloc.construct(_pointer + distance + i, _pointer[distance + i + n]);
-                _alloc.destroy(_pointer + distance + i + n);
-            }
             return begin() + distance;
         }
 
@@ -316,6 +362,259 @@ namespace ft {
           other._size = size;
           other._capacity = capacity;
 		}
+
+    private:
+//		Capacity to switch to when `required` elements no longer fit: geometric growth keeps push_back amortized O(1).
+        size_type recommend(size_type required) const {
+            const size_type max = max_size();
+
+            if (required > max)
+                throw std::logic_error("Error: Incorrect capacity value!");
+            if (_capacity > max / vector_growth<T>::numerator * vector_growth<T>::denominator)
+                return max;
+            size_type next = _capacity * vector_growth<T>::numerator / vector_growth<T>::denominator;
+            return next < required ? required : next;
+        }
+
+//		Elements of such types are relocated and shifted with memcpy and memmove.
+        typedef ft::integral_constant<bool, ft::is_trivially_relocatable<T>::value> relocatable;
+
+//		Copies of such elements are filled with memset and memcpy, which a type that is only relocatable does not allow.
+        typedef ft::integral_constant<bool, ft::is_trivially_copyable<T>::value> copyable;
+
+//		Moves the elements into a fresh buffer of newCapacity and leaves n raw slots at distance.
+        void reallocate(size_type newCapacity, size_type distance, size_type n) {
+            pointer tmp = _alloc.allocate(newCapacity);
+
+            try {
+                relocate_around(tmp, distance, n, relocatable());
+            }
+            catch(...) {
+                _alloc.deallocate(tmp, newCapacity);
+                throw;
+            }
+            if (_capacity)
+                _alloc.deallocate(_pointer, _capacity);
+            _capacity = newCapacity;
+            _pointer = tmp;
+        }
+
+//		A forward range is counted once and constructed straight into its final slots.
+        template <class ForwardIterator>
+        void range_insert(size_type distance, ForwardIterator first, ForwardIterator last, std::forward_iterator_tag) {
+            size_type n = static_cast<size_type>(ft::distance(first, last));
+
+            if (!n)
+                return ;
+            if (_size + n > _capacity || aliases(first)) {
+                size_type newCapacity = _size + n > _capacity ? recommend(_size + n) : _capacity;
+                pointer tmp = _alloc.allocate(newCapacity);
+
+                try {
+                    copy_range(tmp + distance, first, n);
+                    try {
+                        relocate_around(tmp, distance, n, relocatable());
+                    }
+                    catch(...) {
+                        destroy_range(tmp + distance, n);
+                        throw;
+                    }
+                }
+                catch(...) {
+                    _alloc.deallocate(tmp, newCapacity);
+                    throw;
+                }
+                if (_capacity)
+                    _alloc.deallocate(_pointer, _capacity);
+                _capacity = newCapacity;
+                _pointer = tmp;
+            }
+            else {
+                make_gap(distance, n);
+                try {
+                    copy_range(_pointer + distance, first, n);
+                }
+                catch(...) {
+                    _size += n;
+                    close_gap(distance, n);
+                    _size -= n;
+                    throw;
+                }
+            }
+            _size += n;
+        }
+
+//		A single pass input range is appended with the usual growth and then rotated into place.
+        template <class InputIterator>
+        void range_insert(size_type distance, InputIterator first, InputIterator last, std::input_iterator_tag) {
+            size_type old = _size;
+
+            try {
+                for (; first != last; ++first)
+                    push_back(*first);
+            }
+            catch(...) {
+                while (_size > old)
+                    pop_back();
+                throw;
+            }
+            std::rotate(_pointer + distance, _pointer + old, _pointer + _size);
+        }
+
+//		Whether val is one of the elements, which opening a gap or reallocating would move from under it.
+        bool inside(const value_type& val) const {
+            const value_type* address = &val;
+
+            return !std::less<const value_type*>()(address, _pointer) && std::less<const value_type*>()(address, _pointer + _size);
+        }
+
+//		A range read from this vector's own storage would move while the gap opens, it is copied from the old buffer instead.
+//		Only pointers and vector iterators can read it: any other iterator, one handing out proxies included, is taken as apart.
+        template <class ForwardIterator>
+        bool aliases(ForwardIterator) const {
+            return false;
+        }
+
+        template <class U>
+        bool aliases(U* first) const {
+            const void* address = static_cast<const void*>(first);
+
+            return !std::less<const void*>()(address, _pointer) && std::less<const void*>()(address, _pointer + _capacity);
+        }
+
+        template <class U>
+        bool aliases(ft::vector_iterator<U> first) const {
+            return aliases(&*first);
+        }
+
+        template <class U>
+        bool aliases(ft::reverse_iterator<ft::vector_iterator<U> > first) const {
+            return aliases(&*first);
+        }
+
+//		Opens n raw slots at distance, in place when the capacity allows it.
+        void make_gap(size_type distance, size_type n) {
+            if (_size + n > _capacity)
+                reallocate(recommend(_size + n), distance, n);
+            else if (n && distance != _size)
+                shift_right(distance, n, relocatable());
+        }
+
+//		Closes the n already destroyed slots at distance by moving the tail down.
+        void close_gap(size_type distance, size_type n) {
+            if (n && distance + n < _size)
+                shift_left(distance, n, relocatable());
+        }
+
+        void destroy_range(pointer first, size_type n) {
+            for (size_type i = 0; i < n; ++i)
+                _alloc.destroy(first + i);
+        }
+
+//		Copies n elements into raw memory, the copies already made are destroyed if one of them throws.
+        template <class ForwardIterator>
+        void copy_range(pointer dst, ForwardIterator src, size_type n) {
+            size_type i = 0;
+
+            try {
+                for (; i < n; ++i, ++src)
+                    _alloc.construct(dst + i, *src);
+            }
+            catch(...) {
+                destroy_range(dst, i);
+                throw;
+            }
+        }
+
+//		Elements move to their new slots when their move constructor cannot throw (C++11 and later) and are copied otherwise.
+        void move_range(pointer dst, pointer src, size_type n) {
+            size_type i = 0;
+
+            try {
+                for (; i < n; ++i)
+                    _alloc.construct(dst + i, ft::move_if_noexcept(src[i]));
+            }
+            catch(...) {
+                destroy_range(dst, i);
+                throw;
+            }
+        }
+
+        void relocate(pointer dst, pointer src, size_type n, ft::true_type) {
+            if (n)
+                std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src), n * sizeof(T));
+        }
+
+        void relocate_around(pointer tmp, size_type distance, size_type n, ft::true_type) {
+            relocate(tmp, _pointer, distance, ft::true_type());
+            relocate(tmp + distance + n, _pointer + distance, _size - distance, ft::true_type());
+        }
+
+//		Nothing is destroyed before every element was moved or copied, so a throwing copy leaves the vector untouched.
+        void relocate_around(pointer tmp, size_type distance, size_type n, ft::false_type) {
+            move_range(tmp, _pointer, distance);
+            try {
+                move_range(tmp + distance + n, _pointer + distance, _size - distance);
+            }
+            catch(...) {
+                destroy_range(tmp, distance);
+                throw;
+            }
+            destroy_range(_pointer, _size);
+        }
+
+        void shift_right(size_type distance, size_type n, ft::true_type) {
+            std::memmove(static_cast<void*>(_pointer + distance + n), static_cast<const void*>(_pointer + distance), (_size - distance) * sizeof(T));
+        }
+
+        void shift_right(size_type distance, size_type n, ft::false_type) {
+            for (size_type i = _size; i != distance; --i) {
+                _alloc.construct(_pointer + i - 1 + n, ft::move_if_noexcept(_pointer[i - 1]));
+                _alloc.destroy(_pointer + i - 1);
+            }
+        }
+
+        void shift_left(size_type distance, size_type n, ft::true_type) {
+            std::memmove(static_cast<void*>(_pointer + distance), static_cast<const void*>(_pointer + distance + n), (_size - distance - n) * sizeof(T));
+        }
+
+        void shift_left(size_type distance, size_type n, ft::false_type) {
+            for (size_type i = distance; i + n != _size; ++i) {
+                _alloc.construct(_pointer + i, ft::move_if_noexcept(_pointer[i + n]));
+                _alloc.destroy(_pointer + i + n);
+            }
+        }
+
+//		A value made of one repeated byte is written with memset, any other one is doubled with memcpy.
+        void fill(pointer dst, size_type n, const value_type& val, ft::true_type) {
+            const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&val);
+            size_type i = 1;
+
+            if (!n)
+                return ;
+            while (i < sizeof(T) && bytes[i] == bytes[0])
+                ++i;
+            if (i == sizeof(T)) {
+                std::memset(static_cast<void*>(dst), bytes[0], n * sizeof(T));
+                return ;
+            }
+            _alloc.construct(dst, val);
+            for (size_type done = 1; done < n; done *= 2)
+                std::memcpy(static_cast<void*>(dst + done), static_cast<const void*>(dst), (done < n - done ? done : n - done) * sizeof(T));
+        }
+
+        void fill(pointer dst, size_type n, const value_type& val, ft::false_type) {
+            size_type i = 0;
+
+            try {
+                for (; i < n; ++i)
+                    _alloc.construct(dst + i, val);
+            }
+            catch(...) {
+                destroy_range(dst, i);
+                throw;
+            }
+        }
 	};
 
     template <class T, class Alloc>